@@ -0,0 +1,353 @@
+/** === AJEL OS microbenchmarks ===
+ * Times the emulator's hot paths in isolation with Google Benchmark:
+ * executeInstruction per instruction type, frame allocation and eviction
+ * for several frame table sizes, swap file writes and reads as the swap
+ * area grows, and the screen -c instruction parser.
+ *
+ * Every run uses the fixed configuration below, so results from different
+ * commits are comparable. Save and compare them with
+ *   ajel_microbench --benchmark_out=before.json --benchmark_out_format=json
+ *   compare.py benchmarks before.json after.json   (from Google Benchmark's tools)
+ */
+
+#include "ajel.h"
+
+#include <benchmark/benchmark.h>
+
+// ======================= Fixture ======================= //
+
+/**
+ * Fixed configuration for every benchmark. 262144 KB of memory at 64 KB
+ * per frame allows frame tables of up to 4096 frames.
+ */
+const char* MICROBENCH_CONFIG =
+    "num-cpu = 1\nscheduler = rr\nquantum-cycles = 5\nbatch-process-freq = 1\n"
+    "min-ins = 10\nmax-ins = 10\ndelay-per-exec = 0\n"
+    "max-overall-mem = 262144\nmem-per-frame = 64\nmin-mem-per-proc = 64\nmax-mem-per-proc = 65536\n"
+    "max-user-instructions = 1000\nseed = 1\n";
+
+/**
+ * Initializes the emulator once, with its console output discarded.
+ * Returns false (and prints why) if the configuration was rejected.
+ */
+bool initializeMicrobench() {
+    static bool initialized = [] {
+        stringstream discarded;
+        streambuf* consoleBuffer = cout.rdbuf(discarded.rdbuf());
+        stringstream configText(MICROBENCH_CONFIG);
+        initializeSystem(&configText);
+        cout.rdbuf(consoleBuffer);
+        if (!isSystemInitialized) cerr << discarded.str();
+        return isSystemInitialized;
+    }();
+    return initialized;
+}
+
+/**
+ * Empties the frame table and resizes it to frames frames.
+ */
+void resetFrameTable(int frames) {
+    lock_guard<mutex> lock(frameTableMutex);
+    frameTable.assign(frames, FrameInfo());
+    frameEvictionQueue = {};
+    usedFrameCount = 0;
+    dirtyFrameCount = 0;
+}
+
+/**
+ * Creates a process with memorySize bytes and a one-line program. The
+ * process is heap allocated because frames point at their owner.
+ */
+unique_ptr<Process> makeBenchProcess(int memorySize, int pid) {
+    static shared_ptr<const ProgramImage> program = compileProgram("PRINT(\"bench\")", cerr);
+    return make_unique<Process>(createUserProcess("bench" + to_string(pid), memorySize, pid, program));
+}
+
+/**
+ * Frees the swap slots of processes before they are destroyed, so the swap
+ * file does not keep growing from one benchmark to the next.
+ */
+void releaseBenchProcesses(vector<unique_ptr<Process>>& processes) {
+    for (auto& process : processes) swapDevice.release(*process, process->memorySize / systemConfig.mem_per_frame);
+    processes.clear();
+}
+
+/**
+ * Fills every page of process with a recognizable pattern so swapped pages
+ * carry real data.
+ */
+void fillProcessMemory(Process& process) {
+    for (int addr = SYMBOL_TABLE_BYTES; addr < process.memorySize; addr += 2) {
+        writeMemoryWord(process, addr, static_cast<uint16_t>(addr * 31));
+    }
+}
+
+// ===================== Fixture - END ===================== //
+
+// ===================== Interpreter ===================== //
+
+/**
+ * One instruction of each kind, as screen -c would submit it. x and y are
+ * declared by the setup program, and 0x400 lies in a resident page.
+ */
+const pair<const char*, const char*> BENCH_INSTRUCTIONS[] = {
+    { "print", "PRINT(\"Value: \" + x)" },
+    { "declare", "DECLARE z 5" },
+    { "add", "ADD x x 1" },
+    { "subtract", "SUBTRACT x x 1" },
+    { "add-literal", "ADD x 3" },
+    { "read", "READ y 0x400" },
+    { "write", "WRITE 0x400 x" },
+};
+
+/**
+ * executeInstruction on a process whose pages are all resident, so no
+ * iteration faults. Includes the log line each instruction writes.
+ */
+void BM_ExecuteInstruction(benchmark::State& state) {
+    if (!initializeMicrobench()) {
+        state.SkipWithError("system initialization failed");
+        return;
+    }
+    const auto& [label, source] = BENCH_INSTRUCTIONS[state.range(0)];
+    state.SetLabel(label);
+
+    pmr::vector<ProcessInstruction> program;
+    if (!parseInstructionsString(string("DECLARE x 1; DECLARE y 2; ") + source, program, cerr)) {
+        state.SkipWithError("instruction did not parse");
+        return;
+    }
+    const ProcessInstruction& measured = program.back();
+
+    resetFrameTable(64);
+    vector<unique_ptr<Process>> processes;
+    processes.push_back(makeBenchProcess(4096, 1));
+    Process& process = *processes.back();
+    for (int vpn = 0; vpn < process.memorySize / systemConfig.mem_per_frame; ++vpn) allocateFrameForPage(process, vpn);
+
+    ofstream logFile("csopesy-microbench.log", ios::trunc);
+    executeInstruction(&process, program[0], 0, logFile);
+    executeInstruction(&process, program[1], 0, logFile);
+
+    for (auto _ : state) {
+        executeInstruction(&process, measured, 0, logFile);
+    }
+    state.SetItemsProcessed(state.iterations());
+    releaseBenchProcesses(processes);
+}
+BENCHMARK(BM_ExecuteInstruction)->DenseRange(0, size(BENCH_INSTRUCTIONS) - 1);
+
+// ===================== Interpreter - END ===================== //
+
+// ===================== Frame Table ===================== //
+
+/**
+ * allocateFrameForPage with the frame table full, so every call scans for
+ * a free frame, evicts the oldest page (FIFO) and maps the new one. The
+ * pages cycled through are twice the frame count, so each one was evicted
+ * before it is mapped again. Contents are not loaded (no swap I/O).
+ * Args: frame table size.
+ */
+void BM_AllocateFrameForPage(benchmark::State& state) {
+    if (!initializeMicrobench()) {
+        state.SkipWithError("system initialization failed");
+        return;
+    }
+    int frames = static_cast<int>(state.range(0));
+    resetFrameTable(frames);
+
+    const int pagesPerProcess = 65536 / systemConfig.mem_per_frame;
+    vector<unique_ptr<Process>> processes;
+    vector<pair<Process*, int>> pages;
+    while (static_cast<int>(pages.size()) < 2 * frames) {
+        processes.push_back(makeBenchProcess(65536, static_cast<int>(processes.size()) + 1));
+        for (int vpn = 0; vpn < pagesPerProcess && static_cast<int>(pages.size()) < 2 * frames; ++vpn) {
+            pages.emplace_back(processes.back().get(), vpn);
+        }
+    }
+    size_t next = 0;
+    for (int i = 0; i < frames; ++i, ++next) allocateFrameForPage(*pages[next].first, pages[next].second, false);
+
+    for (auto _ : state) {
+        auto [process, vpn] = pages[next];
+        benchmark::DoNotOptimize(allocateFrameForPage(*process, vpn, false));
+        if (++next == pages.size()) next = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+    resetFrameTable(0);
+    releaseBenchProcesses(processes);
+}
+BENCHMARK(BM_AllocateFrameForPage)->Arg(16)->Arg(256)->Arg(4096);
+
+/**
+ * evictFrame on a full frame table, followed by mapping a new page into the
+ * freed frame. With dirty set every page is written before it is evicted,
+ * so the eviction also writes it (and the owner's other dirty pages) to the
+ * swap file. Args: frame table size, dirty.
+ */
+void BM_EvictFrame(benchmark::State& state) {
+    if (!initializeMicrobench()) {
+        state.SkipWithError("system initialization failed");
+        return;
+    }
+    int frames = static_cast<int>(state.range(0));
+    bool dirty = state.range(1) != 0;
+    resetFrameTable(frames);
+
+    const int pagesPerProcess = 65536 / systemConfig.mem_per_frame;
+    vector<unique_ptr<Process>> processes;
+    vector<pair<Process*, int>> pages;
+    while (static_cast<int>(pages.size()) < 2 * frames) {
+        processes.push_back(makeBenchProcess(65536, static_cast<int>(processes.size()) + 1));
+        for (int vpn = 0; vpn < pagesPerProcess && static_cast<int>(pages.size()) < 2 * frames; ++vpn) {
+            pages.emplace_back(processes.back().get(), vpn);
+        }
+    }
+    size_t next = 0;
+    for (int i = 0; i < frames; ++i, ++next) {
+        allocateFrameForPage(*pages[next].first, pages[next].second, false);
+        if (dirty) markPageDirty(*pages[next].first, pages[next].second);
+    }
+
+    int writesBefore = pageReplacements.load();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(evictFrame());
+        auto [process, vpn] = pages[next];
+        allocateFrameForPage(*process, vpn, false);
+        if (dirty) markPageDirty(*process, vpn);
+        if (++next == pages.size()) next = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["pages_written"] = benchmark::Counter(pageReplacements.load() - writesBefore,
+        benchmark::Counter::kAvgIterations);
+    resetFrameTable(0);
+    releaseBenchProcesses(processes);
+}
+BENCHMARK(BM_EvictFrame)->ArgsProduct({ { 16, 256, 4096 }, { 0, 1 } });
+
+// ===================== Frame Table - END ===================== //
+
+// ===================== Backing Store ===================== //
+
+/**
+ * savePageToBackingStore cycling over every page of the swap area.
+ * Args: swap area size in pages, spread over processes of at most 1024 pages.
+ */
+void BM_SavePageToBackingStore(benchmark::State& state) {
+    if (!initializeMicrobench() || !swapDevice.isOpen()) {
+        state.SkipWithError("no swap file");
+        return;
+    }
+    int swapPages = static_cast<int>(state.range(0));
+    const int pagesPerProcess = min(swapPages, 65536 / systemConfig.mem_per_frame);
+
+    vector<unique_ptr<Process>> processes;
+    for (int pages = 0; pages < swapPages; pages += pagesPerProcess) {
+        processes.push_back(makeBenchProcess(pagesPerProcess * systemConfig.mem_per_frame, static_cast<int>(processes.size()) + 1));
+        fillProcessMemory(*processes.back());
+    }
+
+    int page = 0;
+    for (auto _ : state) {
+        savePageToBackingStore(*processes[page / pagesPerProcess], page % pagesPerProcess);
+        if (++page == swapPages) page = 0;
+    }
+    state.SetBytesProcessed(state.iterations() * systemConfig.mem_per_frame);
+    releaseBenchProcesses(processes);
+}
+BENCHMARK(BM_SavePageToBackingStore)->RangeMultiplier(8)->Range(16, 16384);
+
+/**
+ * loadPagesFromBackingStore reading batch adjacent pages per call, cycling
+ * over a swap area that was written in full beforehand.
+ * Args: swap area size in pages, pages per call.
+ */
+void BM_LoadPagesFromBackingStore(benchmark::State& state) {
+    if (!initializeMicrobench() || !swapDevice.isOpen()) {
+        state.SkipWithError("no swap file");
+        return;
+    }
+    int swapPages = static_cast<int>(state.range(0));
+    int batch = static_cast<int>(state.range(1));
+    const int pagesPerProcess = min(swapPages, 65536 / systemConfig.mem_per_frame);
+
+    vector<unique_ptr<Process>> processes;
+    for (int pages = 0; pages < swapPages; pages += pagesPerProcess) {
+        processes.push_back(makeBenchProcess(pagesPerProcess * systemConfig.mem_per_frame, static_cast<int>(processes.size()) + 1));
+        Process& process = *processes.back();
+        fillProcessMemory(process);
+        vector<int> all(pagesPerProcess);
+        for (int vpn = 0; vpn < pagesPerProcess; ++vpn) all[vpn] = vpn;
+        savePagesToBackingStore(process, all);
+    }
+
+    int page = 0;
+    vector<int> vpns(batch);
+    for (auto _ : state) {
+        for (int i = 0; i < batch; ++i) vpns[i] = page % pagesPerProcess + i;
+        benchmark::DoNotOptimize(loadPagesFromBackingStore(*processes[page / pagesPerProcess], vpns));
+        page += batch;
+        if (page >= swapPages) page = 0;
+    }
+    state.SetBytesProcessed(state.iterations() * batch * systemConfig.mem_per_frame);
+    releaseBenchProcesses(processes);
+}
+BENCHMARK(BM_LoadPagesFromBackingStore)->ArgsProduct({ { 16, 1024, 16384 }, { 1, 8 } });
+
+// ===================== Backing Store - END ===================== //
+
+// ===================== Parser ===================== //
+
+/**
+ * Programs of increasing size: a typical screen -c line, the full
+ * max-user-instructions budget of straight-line code, and nested FOR loops
+ * that unroll to 4096 instructions.
+ */
+string benchParserProgram(int kind) {
+    if (kind == 0) return "DECLARE x 5; ADD x x 1; PRINT(\"Result: \" + x); WRITE 0x500 x; READ y 0x500";
+    stringstream program;
+    if (kind == 1) {
+        for (int i = 0; i < 200; ++i) {
+            program << "DECLARE v" << i % 20 << " " << i << "; ADD v" << i % 20 << " v" << (i + 1) % 20
+                << " 7; WRITE 0x" << hex << 0x100 + i * 2 << dec << " v" << i % 20 << "; PRINT(\"step \" + v"
+                << i % 20 << "); ";
+        }
+        return program.str();
+    }
+    return "DECLARE x 0; FOR([FOR([FOR([ADD x x 1; SUBTRACT x x 1; WRITE 0x200 x; PRINT(\"x = \" + x)], 16)], 8)], 8)";
+}
+
+void BM_ParseInstructionsString(benchmark::State& state) {
+    if (!initializeMicrobench()) {
+        state.SkipWithError("system initialization failed");
+        return;
+    }
+    static const char* labels[] = { "screen-c line", "800 statements", "nested FOR" };
+    state.SetLabel(labels[state.range(0)]);
+    string source = benchParserProgram(static_cast<int>(state.range(0)));
+
+    size_t instructions = 0;
+    for (auto _ : state) {
+        pmr::vector<ProcessInstruction> program;
+        if (!parseInstructionsString(source, program, cerr)) {
+            state.SkipWithError("program did not parse");
+            break;
+        }
+        instructions = program.size();
+        benchmark::DoNotOptimize(program.data());
+    }
+    state.SetBytesProcessed(state.iterations() * source.size());
+    state.counters["instructions"] = static_cast<double>(instructions);
+}
+BENCHMARK(BM_ParseInstructionsString)->DenseRange(0, 2);
+
+// ===================== Parser - END ===================== //
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    shutdownSystem();
+    return 0;
+}
@@ -0,0 +1,2231 @@
+/** === AJEL OS emulator core ===
+ * Types, global state and functions shared by the emulator library
+ * (the src/ .cpp files) and the programs built on it: the ajel CLI
+ * (GroupHomework.cpp) and the microbenchmarks (bench/microbench.cpp).
+ */
+#pragma once
+
+ // ======================= Libraries ======================= //
+
+#ifdef _WIN32  // For UTF-8 display
+#include <windows.h>  // For UTF-8 display
+#include <io.h>       // For the swap file (_open, _lseeki64, _read, _write)
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>    // For the swap file (open, preadv, pwritev)
+#include <unistd.h>
+#include <sys/uio.h>
+#endif  // For UTF-8 display
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define AJEL_HAVE_IO_URING 1 // Async page-ins through the raw io_uring syscalls (no liburing needed)
+#include <linux/io_uring.h>
+#undef BLOCK_SIZE // Defined by <linux/fs.h>, which io_uring.h includes
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <cerrno>
+#endif
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <ctime>
+#include <iomanip>  // For put_time
+#include <sstream>  // For stringstream
+#include <cstdlib>  // For system("clear") or system("cls")
+#include <fstream>  // For file I/O (ofstream)
+#include <queue>    // For the ready queue of processes
+#include <condition_variable> // For thread synchronization
+#include <algorithm>
+#include <cstdint> // For uint16_t
+#include <atomic> // For VMStat
+#include <charconv> // For from_chars (instruction parser)
+#include <string_view>
+#include <cmath> // For log2 and pow
+#include <memory> // For shared_ptr (process status registry)
+#include <map> // For globalProcesses (stable addresses on insert/erase)
+#include <unordered_set>
+#include <list> // For the compressed swap pool's LRU order
+#include <random> // For random_device (default seed)
+#include <cstring> // For memcpy (page transfers)
+#include <memory_resource> // For the per-process arenas
+
+
+// ===================== Libraries - END ===================== //
+
+using namespace std;
+
+// ===================== Forward Declarations & Core Structs ===================== //
+
+void displayHeader();
+
+
+/**
+ * Represents a physical memory frame in the system.
+ */
+struct FrameInfo {
+    bool isFree = true;
+    int ownerPID = -1;
+    struct Process* owner = nullptr; // Valid while the frame is in use
+    int virtualPageNumber = -1; // Which virtual page is stored here
+    bool dirty = false;
+    bool referenced = false;
+    vector<struct Process*> sharers; // Forked relatives also mapping this page copy-on-write
+};
+
+/**
+ * Represents an entry in a process's page table. Another core may clear valid
+ * or set hasSwapCopy while evicting (under frameTableMutex); the owning
+ * process reads both without the lock, so they are atomic.
+ */
+struct PageTableEntry {
+    int virtualPageNumber = -1;
+    int frameNumber = -1;
+    atomic<bool> valid{ false };
+    bool dirty = false;
+    bool referenced = false;
+    atomic<bool> hasSwapCopy{ false }; // The backing store holds the current contents; otherwise they are in the memory image
+    bool prefetched = false;  // Brought in by the prefetcher and not accessed yet
+    bool cow = false;         // Shared with a forked relative; a write copies it first (breakCopyOnWrite)
+};
+
+/**
+ * Shape of the workload built by scheduler-start: the relative weight of each
+ * generated instruction type and how READ/WRITE addresses are distributed.
+ */
+struct WorkloadProfile {
+    enum AddressDistribution { UNIFORM, ZIPF, SEQUENTIAL, STRIDE, HOT_COLD, PHASED };
+
+    // instruction-mix weights (FOR is never generated)
+    int mix_print = 1;
+    int mix_declare = 1;
+    int mix_add = 1;
+    int mix_subtract = 1;
+    int mix_read = 1;
+    int mix_write = 1;
+
+    AddressDistribution address_distribution = UNIFORM;
+    double zipf_exponent = 1.0; // Skew of the zipf distribution (> 0)
+
+    // Locality models
+    int address_stride = 2;            // stride: bytes between consecutive accesses
+    double hot_fraction = 0.2;         // hot-cold: share of the address space that is hot
+    double hot_probability = 0.8;      // hot-cold: share of accesses that go to the hot region
+    int working_set_pages = 2;         // phased: contiguous pages touched during one phase
+    int phase_length = 50;             // phased: accesses before the working set moves
+
+    int totalMixWeight() const {
+        return mix_print + mix_declare + mix_add + mix_subtract + mix_read + mix_write;
+    }
+
+    bool isValid() const {
+        return mix_print >= 0 && mix_declare >= 0 && mix_add >= 0 && mix_subtract >= 0 &&
+            mix_read >= 0 && mix_write >= 0 && totalMixWeight() > 0 && zipf_exponent > 0 &&
+            address_stride > 0 && hot_fraction > 0 && hot_fraction <= 1 &&
+            hot_probability >= 0 && hot_probability <= 1 && working_set_pages > 0 && phase_length > 0;
+    }
+};
+
+// --- Configuration Struct ---
+struct SystemConfig {
+    int num_cpu;
+    string scheduler;
+    int quantum_cycles;
+    int batch_process_freq;
+    int min_ins;
+    int max_ins;
+    int delay_per_exec;
+    // Memory allocation parameters
+    int max_overall_mem;
+    int mem_per_frame;
+    int min_mem_per_proc;
+    int max_mem_per_proc;
+    // Optional: periodic Prometheus text export (disabled when interval is 0)
+    int metrics_export_interval;
+    string metrics_export_file;
+    // Optional: workload generated by scheduler-start
+    int num_processes;
+    uint64_t seed;
+    bool has_seed; // False => a random seed is picked (and printed) at initialize
+    WorkloadProfile workload;
+    int instruction_chunk_size; // Generated instructions materialized at a time (0 = whole program, cached as a ProgramImage)
+    int prefetch_pages;         // Pages read ahead once a sequential/strided fault pattern is seen (0 = off)
+    int fault_around_pages;     // Swapped neighbors on each side brought in with a swap-in (0 = off)
+    string page_fault_io;       // sync, async (io_uring if available, else threads), io_uring or threads
+    int io_threads;             // Swap-in threads for the threads backend
+    int compressed_pool_size;   // Bytes of compressed evicted pages kept in RAM ahead of the swap file (0 = off)
+    int max_user_instructions;  // Instructions allowed in a screen -c / submit program, FOR bodies included
+    // Constructor
+    SystemConfig() :
+        num_cpu(0),
+        scheduler(""),
+        quantum_cycles(0),
+        batch_process_freq(0),
+        min_ins(0),
+        max_ins(0),
+        delay_per_exec(0),
+        max_overall_mem(0),
+        mem_per_frame(0),
+        min_mem_per_proc(0),
+        max_mem_per_proc(0),
+        metrics_export_interval(0),
+        metrics_export_file("csopesy-metrics.prom"),
+        num_processes(10),
+        seed(0),
+        has_seed(false),
+        instruction_chunk_size(256),
+        prefetch_pages(0),
+        fault_around_pages(0),
+        page_fault_io("sync"),
+        io_threads(2),
+        compressed_pool_size(0),
+        max_user_instructions(50) {
+    }
+
+    // Method to validate configuration
+    bool isValid() const {
+        return num_cpu > 0 &&
+            !scheduler.empty() &&
+            quantum_cycles > 0 &&
+            batch_process_freq > 0 &&
+            min_ins > 0 &&
+            max_ins > 0 &&
+            max_ins >= min_ins &&
+            delay_per_exec >= 0 &&
+            // New memory validation
+            max_overall_mem > 0 &&
+            mem_per_frame > 0 &&
+            min_mem_per_proc > 0 &&
+            max_mem_per_proc > 0 &&
+            max_mem_per_proc >= min_mem_per_proc &&
+            mem_per_frame <= max_overall_mem &&
+            metrics_export_interval >= 0 &&
+            num_processes > 0 &&
+            workload.isValid() &&
+            instruction_chunk_size >= 0 &&
+            prefetch_pages >= 0 &&
+            fault_around_pages >= 0 &&
+            (page_fault_io == "sync" || page_fault_io == "async" ||
+                page_fault_io == "io_uring" || page_fault_io == "threads") &&
+            io_threads > 0 &&
+            compressed_pool_size >= 0 &&
+            max_user_instructions > 0;
+            //max_mem_per_proc <= max_overall_mem;
+    }
+};
+
+// --- Global System Configuration and Memory Structures ---
+extern SystemConfig systemConfig;
+extern vector<FrameInfo> frameTable;
+extern mutex frameTableMutex;
+extern std::queue<int> frameEvictionQueue;
+
+/**
+ * Page replacement class definition. Needs frameTable to be declared first.
+ */
+class ImprovedPageReplacement {
+private:
+    queue<pair<int, int>> pageQueue; // <frameIndex, timestamp>
+    int timestamp_counter = 0;
+    mutex replacement_mutex;
+
+public:
+    void addPage(int frameIndex) {
+        lock_guard<mutex> lock(replacement_mutex);
+        pageQueue.push({ frameIndex, timestamp_counter++ });
+    }
+
+    int evictPage() {
+        lock_guard<mutex> lock(replacement_mutex);
+
+        while (!pageQueue.empty()) {
+            auto [frameIndex, timestamp] = pageQueue.front();
+            pageQueue.pop();
+
+            // Verify frame is still valid for eviction
+            if (frameIndex >= 0 && frameIndex < frameTable.size() && !frameTable[frameIndex].isFree) {
+                return frameIndex;
+            }
+        }
+        return -1;
+    }
+
+    bool isEmpty() {
+        lock_guard<mutex> lock(replacement_mutex);
+        return pageQueue.empty();
+    }
+};
+
+/**
+ * xoshiro256** pseudo-random generator. Unlike rand() it has no shared state,
+ * so every generator thread can own one, and a given seed always produces the
+ * same sequence on every platform.
+ */
+class FastRandom {
+private:
+    uint64_t state[4];
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    explicit FastRandom(uint64_t seed = 0) {
+        // Expand the seed with splitmix64 so nearby seeds give unrelated streams
+        for (auto& word : state) {
+            seed += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    /**
+     * Independent stream for the given index, e.g. one per generated process.
+     */
+    static FastRandom forStream(uint64_t seed, uint64_t stream) {
+        return FastRandom(seed ^ (stream * 0xD1B54A32D192ED03ULL));
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Uniform integer in [0, bound), drop-in for rand() % bound
+    int below(int bound) {
+        return bound > 0 ? static_cast<int>(((next() >> 32) * static_cast<uint64_t>(bound)) >> 32) : 0;
+    }
+
+    // Uniform double in [0, 1)
+    double unit() {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Raw state bytes; equal keys produce equal sequences
+    string stateKey() const {
+        return string(reinterpret_cast<const char*>(state), sizeof(state));
+    }
+};
+
+/**
+ * HDR-style latency histogram. Values (in microseconds) are grouped into
+ * log-linear buckets: 16 linear sub-buckets per power of two, which keeps
+ * every recorded value within ~6% of its bucket bounds. Recording is lock-free
+ * so worker threads can sample without touching any of the scheduler mutexes.
+ */
+class LatencyHistogram {
+private:
+    static const int SUB_BUCKET_BITS = 4;
+    static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static const int BUCKET_COUNT = 64 * SUB_BUCKET_COUNT;
+
+    atomic<uint64_t> buckets[BUCKET_COUNT];
+    atomic<uint64_t> totalCount{ 0 };
+    atomic<uint64_t> totalSum{ 0 };
+    atomic<uint64_t> minValue{ UINT64_MAX };
+    atomic<uint64_t> maxValue{ 0 };
+
+    static int bucketIndex(uint64_t value) {
+        if (value < SUB_BUCKET_COUNT) return static_cast<int>(value);
+        int msb = 0;
+        while ((value >> (msb + 1)) != 0) msb++;
+        int shift = msb - SUB_BUCKET_BITS;
+        return (shift + 1) * SUB_BUCKET_COUNT + static_cast<int>((value >> shift) - SUB_BUCKET_COUNT);
+    }
+
+    // Highest value that falls into the given bucket
+    static uint64_t bucketUpperBound(int index) {
+        if (index < SUB_BUCKET_COUNT) return static_cast<uint64_t>(index);
+        int shift = index / SUB_BUCKET_COUNT - 1;
+        uint64_t sub = static_cast<uint64_t>(index % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT);
+        return ((sub + 1) << shift) - 1;
+    }
+
+public:
+    LatencyHistogram() {
+        reset();
+    }
+
+    void record(uint64_t micros) {
+        buckets[bucketIndex(micros)].fetch_add(1, memory_order_relaxed);
+        totalCount.fetch_add(1, memory_order_relaxed);
+        totalSum.fetch_add(micros, memory_order_relaxed);
+
+        uint64_t seen = minValue.load(memory_order_relaxed);
+        while (micros < seen && !minValue.compare_exchange_weak(seen, micros, memory_order_relaxed)) {}
+        seen = maxValue.load(memory_order_relaxed);
+        while (micros > seen && !maxValue.compare_exchange_weak(seen, micros, memory_order_relaxed)) {}
+    }
+
+    void recordSince(chrono::steady_clock::time_point since) {
+        auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - since);
+        record(elapsed.count() > 0 ? static_cast<uint64_t>(elapsed.count()) : 0);
+    }
+
+    void reset() {
+        for (auto& bucket : buckets) bucket.store(0, memory_order_relaxed);
+        totalCount.store(0, memory_order_relaxed);
+        totalSum.store(0, memory_order_relaxed);
+        minValue.store(UINT64_MAX, memory_order_relaxed);
+        maxValue.store(0, memory_order_relaxed);
+    }
+
+    uint64_t count() const { return totalCount.load(memory_order_relaxed); }
+    uint64_t sum() const { return totalSum.load(memory_order_relaxed); }
+    uint64_t minimum() const { return count() > 0 ? minValue.load(memory_order_relaxed) : 0; }
+    uint64_t maximum() const { return maxValue.load(memory_order_relaxed); }
+
+    double mean() const {
+        uint64_t n = count();
+        return n > 0 ? static_cast<double>(totalSum.load(memory_order_relaxed)) / n : 0.0;
+    }
+
+    /**
+     * Returns the value at the given percentile (0-100), reported as the upper
+     * bound of the bucket it falls into and clamped to the recorded maximum.
+     */
+    uint64_t percentile(double pct) const {
+        uint64_t n = count();
+        if (n == 0) return 0;
+        uint64_t target = static_cast<uint64_t>(ceil(pct / 100.0 * n));
+        if (target == 0) target = 1;
+
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKET_COUNT; ++i) {
+            seen += buckets[i].load(memory_order_relaxed);
+            if (seen >= target) {
+                uint64_t upper = bucketUpperBound(i);
+                return upper < maximum() ? upper : maximum();
+            }
+        }
+        return maximum();
+    }
+};
+
+
+// ======================= Global Variables ======================= //
+
+extern atomic<bool> isSchedulerRunning; // Polled by the CPU workers, the admission scheduler and the CLI
+extern bool isSystemInitialized; // New flag to track system initialization
+extern thread schedulerThread;
+extern vector<thread> cpu_workers;
+
+extern mutex processMutex; // Used for protecting shared resources like globalProcesses and cout
+extern map<int, struct Process> globalProcesses; // Live processes by PID; finished ones are retired to processArchive
+extern bool screenActive;
+
+extern mutex screensMutex;
+extern unordered_map<string, class Screen> screens;
+
+// Copy-on-write list of every process's published status. Readers take a
+// reference with atomic_load and never block; writers serialize on the mutex.
+extern shared_ptr<const vector<shared_ptr<struct ProcessStatus>>> processStatusRegistry;
+extern mutex statusRegistryMutex;
+extern int archivedInRegistry; // Registry entries already in processArchive (pruned in bulk)
+
+// Append-only summaries of retired (finished) processes, in retirement order
+extern vector<struct ProcessStatusView> processArchive;
+extern mutex processArchiveMutex;
+
+// screen -f requests, run by the worker that owns the parent at the end of its next time slice
+extern unordered_map<int, vector<string>> pendingForks; // Parent PID -> child names
+extern mutex pendingForksMutex;
+extern atomic<int> pendingForkCount;
+
+// --- Threading & Scheduling Variables ---
+extern queue<struct Process*> ready_queue; // Queue of processes ready for CPU execution
+extern mutex queue_mutex;                  // Mutex to protect the ready_queue
+extern condition_variable scheduler_cv;    // Notifies worker threads about new processes
+
+// --- Memory Management Variables ---
+extern atomic<int> current_memory_used;
+extern mutex memory_mutex;
+extern condition_variable memory_cv; // Notifies the admission scheduler about freed memory
+extern queue<struct Process*> waiting_for_memory_queue; // Processes waiting for memory allocation
+extern mutex waiting_queue_mutex;
+
+extern atomic<int> quantumCycleCounter; // Numbers the memory snapshots written by every core
+extern int nextPID;
+extern ImprovedPageReplacement pageReplacer;
+
+// --- For VMStat ---
+extern atomic<int> pageFaults;
+extern atomic<int> pageReplacements;
+extern atomic<int> pagesPagedIn;   // Faults served from the backing store
+extern atomic<int> zeroFillFaults; // Faults on never-swapped pages, served without I/O
+extern atomic<int> pagesPrefetched;
+extern atomic<int> prefetchHits;     // Prefetched pages that were accessed before eviction
+extern atomic<int> swapReadCalls;    // Vectored reads issued to the swap file
+extern atomic<int> swapWriteCalls;   // Vectored writes issued to the swap file
+extern atomic<int> asyncPageIns;     // Faults whose swap-in ran while the core moved on
+extern atomic<int> pagesCompressed;  // Evicted pages stored in the compressed pool instead of the swap file
+extern atomic<int> compressedPoolHits; // Pages loaded from the compressed pool without I/O
+extern atomic<int> pagesSpilled;     // Cold pool entries moved to the swap file to make room
+extern atomic<int> compressedPoolPages;
+extern atomic<long long> compressedPoolBytes;
+extern atomic<int> cowFaults;       // Faults on copy-on-write pages, served from the shared copy without I/O
+extern atomic<int> cowPageCopies;   // Shared pages copied by a write
+extern atomic<int> sharedPageWrites; // Writes recorded on a page still shared copy-on-write; always 0 unless a breakCopyOnWrite is missing
+extern atomic<int> processesForked;
+extern atomic<int> programImages;        // Live shared program images
+extern atomic<int> programCacheHits;     // Processes that reused a cached program image
+extern atomic<int> programCacheMisses;   // Program images built
+extern atomic<int> blockedOnIoCount; // Processes parked until their swap-in completes
+extern atomic<int> totalCpuTicks;
+extern atomic<int> activeCpuTicks;
+extern atomic<int> idleCpuTicks;
+
+// --- Lock-free counters for the metrics snapshot (vmstat --json, Prometheus export) ---
+extern atomic<int> processesCreated;
+extern atomic<int> processesStarted;
+extern atomic<int> processesFinished;
+extern atomic<int> processesViolated;
+extern atomic<int> usedFrameCount;
+extern atomic<int> dirtyFrameCount;
+extern atomic<int> busyCoreCount;
+extern vector<atomic<long long>> coreBusyMicros; // Time each core spent running processes; sized by initializeSystem()
+extern atomic<int> readyQueueDepth;
+extern atomic<int> waitingQueueDepth;
+extern atomic<long long> instructionsExecuted;
+
+extern thread metricsExporterThread;
+extern atomic<bool> isMetricsExporterRunning;
+extern mutex metrics_exporter_mutex;
+extern condition_variable metrics_exporter_cv; // Wakes the exporter early on shutdown
+
+// --- Process memory layout ---
+// Symbol table segment at the start of every process's page 0
+const int SYMBOL_TABLE_SLOTS = 32;
+const int SYMBOL_TABLE_BYTES = SYMBOL_TABLE_SLOTS * 2;
+
+// First block a process arena takes from the heap; later blocks grow geometrically
+const size_t PROCESS_ARENA_INITIAL_BYTES = 4096;
+
+// --- For screen -ls and report-util ---
+// Retired processes they list; the totals come from the history counters and report-util --all lists every one
+const size_t REPORT_RECENT_RETIRED = 20;
+
+// --- For perf-stats (latency histograms, in microseconds) ---
+const int INSTRUCTION_TYPE_COUNT = 7; // Must match ProcessInstruction::Type
+extern LatencyHistogram readyQueueWaitHist;     // ready_queue push -> pop in cpu_worker_main
+extern LatencyHistogram admissionWaitHist;      // waiting_for_memory_queue push -> admission
+extern LatencyHistogram turnaroundHist;         // endClock - startClock of finished processes
+extern LatencyHistogram pageInWaitHist;         // Time a process spends blocked on an async swap-in
+extern LatencyHistogram instructionExecHist[INSTRUCTION_TYPE_COUNT]; // executeInstruction() by type
+
+// ===================== Global Variables - END ===================== //
+
+
+// ===================== Structures ===================== //
+
+/**
+ * Represents a single process instruction. Its strings and loop body take the
+ * memory resource of the list that holds it (uses-allocator construction), so
+ * a streamed chunk lives entirely in its process's chunkPool; shared
+ * ProgramImages use the default heap.
+ */
+struct ProcessInstruction {
+    enum Type {
+        PRINT, DECLARE, ADD, SUBTRACT, FOR_LOOP, READ, WRITE
+    };
+    using allocator_type = pmr::polymorphic_allocator<char>;
+
+    Type type{}; // FIX: Initialize the enum
+    pmr::string var_name;
+    int value = 0;
+    pmr::string message;
+    pmr::vector<ProcessInstruction> loop_body;
+    int loop_count = 0;
+    int memory_address = 0;
+
+    bool is_three_operand = false; // For ADD/SUBTRACT var1 var2 var3
+    pmr::string arg1_var; // Empty when the operand is the literal arg1_value
+    pmr::string arg2_var;
+    int arg1_value = 0;
+    int arg2_value = 0;
+    bool print_has_variable = false; // For PRINT "message" + var
+
+    // Symbol table slots of var_name/arg1_var/arg2_var, resolved once by
+    // resolveSymbolSlots (-1 = no slot: never declared or table full)
+    int var_slot = -1;
+    int arg1_slot = -1;
+    int arg2_slot = -1;
+
+    ProcessInstruction() = default;
+    ProcessInstruction(const ProcessInstruction&) = default;
+    ProcessInstruction(ProcessInstruction&&) = default;
+    ProcessInstruction& operator=(const ProcessInstruction&) = default;
+    ProcessInstruction& operator=(ProcessInstruction&&) = default;
+
+    explicit ProcessInstruction(const allocator_type& alloc)
+        : var_name(alloc), message(alloc), loop_body(alloc), arg1_var(alloc), arg2_var(alloc) {
+    }
+    // Assignment keeps each member's resource, so these copy into alloc
+    ProcessInstruction(const ProcessInstruction& other, const allocator_type& alloc) : ProcessInstruction(alloc) {
+        *this = other;
+    }
+    ProcessInstruction(ProcessInstruction&& other, const allocator_type& alloc) : ProcessInstruction(alloc) {
+        *this = move(other);
+    }
+};
+
+/**
+ * A parsed, slot-resolved program. Immutable once built, so every process
+ * running the same program shares one copy; a process keeps only its own
+ * program counter and symbol table.
+ */
+struct ProgramImage {
+    pmr::vector<ProcessInstruction> instructions;
+    int totalTasks = 0; // Instructions executed, counting FOR loop iterations
+};
+
+/**
+ * Content-keyed cache of program images. A key is the program's source (the
+ * screen -c instruction string) or the generator stream it is drawn from, so
+ * a hit skips parsing or generation as well as the copy. Entries are weak:
+ * an image is freed when the last process running it is retired.
+ *
+ * Processes share images when they run identical screen -c / submit sources
+ * or are forked. Generated programs rarely do: every process index draws from
+ * its own stream, so only the same process of a later scheduler-start with the
+ * same seed hits, and streamed programs (instruction-chunk-size > 0, the
+ * default) bypass the cache altogether.
+ */
+class ProgramCache {
+private:
+    mutex cacheMutex;
+    unordered_map<string, weak_ptr<const ProgramImage>> images;
+    size_t pruneAt = 64; // Drop expired entries once the map grows past this
+
+public:
+    /**
+     * Returns the live image for key, or nullptr.
+     */
+    shared_ptr<const ProgramImage> find(const string& key) {
+        lock_guard<mutex> lock(cacheMutex);
+        auto it = images.find(key);
+        shared_ptr<const ProgramImage> image = it != images.end() ? it->second.lock() : nullptr;
+        if (image) programCacheHits++;
+        return image;
+    }
+
+    /**
+     * Publishes a newly built image under key and returns the image to use.
+     * If another thread published the same program first, that one wins and
+     * image is dropped.
+     */
+    shared_ptr<const ProgramImage> insert(const string& key, ProgramImage&& built) {
+        lock_guard<mutex> lock(cacheMutex);
+        weak_ptr<const ProgramImage>& slot = images[key];
+        if (shared_ptr<const ProgramImage> existing = slot.lock()) {
+            programCacheHits++;
+            return existing;
+        }
+
+        programCacheMisses++;
+        programImages++;
+        shared_ptr<const ProgramImage> image(new ProgramImage(move(built)), [](const ProgramImage* p) {
+            programImages--;
+            delete p;
+        });
+        slot = image;
+
+        if (images.size() > pruneAt) {
+            for (auto it = images.begin(); it != images.end();) {
+                if (it->second.expired()) it = images.erase(it);
+                else ++it;
+            }
+            pruneAt = max<size_t>(64, images.size() * 2);
+        }
+        return image;
+    }
+
+    void clear() {
+        lock_guard<mutex> lock(cacheMutex);
+        images.clear();
+        pruneAt = 64;
+    }
+};
+
+extern ProgramCache programCache;
+
+/**
+ * Returns the mnemonic of an instruction type, used by perf-stats.
+ */
+inline const char* instructionTypeName(int type) {
+    static const char* names[INSTRUCTION_TYPE_COUNT] = {
+        "PRINT", "DECLARE", "ADD", "SUBTRACT", "FOR", "READ", "WRITE"
+    };
+    return (type >= 0 && type < INSTRUCTION_TYPE_COUNT) ? names[type] : "UNKNOWN";
+}
+
+/**
+ * Plain copy of a process's published status, as read by the reporters.
+ */
+struct ProcessStatusView {
+    enum State { WAITING, RUNNING, FINISHED, VIOLATION, BLOCKED }; // BLOCKED = waiting on a swap-in
+
+    string name;
+    int pid = -1;
+    int memorySize = 0;
+    State state = WAITING;
+    int core = -1;
+    int tasksCompleted = 0;
+    int totalTasks = 0;
+    int residentPages = 0;
+    time_t startTime = 0;
+    time_t endTime = 0;
+    string violationAddress;
+};
+
+/**
+ * Status of a process published for screen -ls, process-smi and report-util.
+ *
+ * The worker that currently owns the process is the only writer; it publishes
+ * through a seqlock so reporters get a consistent view without taking any lock
+ * a CPU worker needs. residentPages is a standalone gauge because frames are
+ * evicted by other threads.
+ */
+struct ProcessStatus {
+    const string name;
+    const int pid;
+    const int memorySize;
+
+    atomic<int> residentPages{ 0 };
+    atomic<bool> archived{ false }; // Summary is in processArchive
+
+    ProcessStatus(const string& processName, int memSize, int id)
+        : name(processName), pid(id), memorySize(memSize) {
+    }
+
+    void publish(ProcessStatusView::State state, int core, int tasksCompleted, int totalTasks,
+        time_t startTime, time_t endTime, const string& violationAddr) {
+        seq.fetch_add(1, memory_order_acq_rel); // Odd: readers that overlap this retry
+
+        // Written once, before VIOLATION becomes visible; only read once it is
+        if (state == ProcessStatusView::VIOLATION && violationAddress.empty()) {
+            violationAddress = violationAddr;
+        }
+        // Release stores: a reader that sees any of these values also sees the odd seq
+        publishedState.store(state, memory_order_release);
+        publishedCore.store(core, memory_order_release);
+        publishedTasksCompleted.store(tasksCompleted, memory_order_release);
+        publishedTotalTasks.store(totalTasks, memory_order_release);
+        publishedStartTime.store(static_cast<long long>(startTime), memory_order_release);
+        publishedEndTime.store(static_cast<long long>(endTime), memory_order_release);
+
+        seq.fetch_add(1, memory_order_release);
+    }
+
+    ProcessStatusView read() const {
+        ProcessStatusView view;
+        view.name = name;
+        view.pid = pid;
+        view.memorySize = memorySize;
+
+        unsigned before, after = 0;
+        do {
+            before = seq.load(memory_order_acquire);
+            if (before & 1) {
+                this_thread::yield(); // Writer is mid-update
+                continue;
+            }
+            view.state = static_cast<ProcessStatusView::State>(publishedState.load(memory_order_acquire));
+            view.core = publishedCore.load(memory_order_acquire);
+            view.tasksCompleted = publishedTasksCompleted.load(memory_order_acquire);
+            view.totalTasks = publishedTotalTasks.load(memory_order_acquire);
+            view.startTime = static_cast<time_t>(publishedStartTime.load(memory_order_acquire));
+            view.endTime = static_cast<time_t>(publishedEndTime.load(memory_order_acquire));
+            after = seq.load(memory_order_acquire);
+        } while ((before & 1) || before != after);
+
+        if (view.state == ProcessStatusView::VIOLATION) {
+            view.violationAddress = violationAddress;
+        }
+        view.residentPages = residentPages.load(memory_order_relaxed);
+        return view;
+    }
+
+private:
+    atomic<unsigned> seq{ 0 }; // Odd while a publish is in progress
+    atomic<int> publishedState{ ProcessStatusView::WAITING };
+    atomic<int> publishedCore{ -1 };
+    atomic<int> publishedTasksCompleted{ 0 };
+    atomic<int> publishedTotalTasks{ 0 };
+    atomic<long long> publishedStartTime{ 0 };
+    atomic<long long> publishedEndTime{ 0 };
+    string violationAddress;
+};
+
+/**
+ * Page contents shared copy-on-write by forked processes. Never written
+ * while shared; freed by whichever process drops the last reference.
+ */
+struct SharedPage {
+    atomic<int> refs{ 1 };
+    vector<uint16_t> words;
+};
+
+/**
+ * A process's virtual memory as page-sized word buffers. A page is only
+ * allocated (zero-filled) when it is first written or loaded; reads of an
+ * untouched page return 0. Memory is word-addressed: an odd byte address
+ * refers to the word that contains it. After a fork, pages point into
+ * SharedPages until touchPage gives the writer its own copy.
+ */
+struct MemoryImage {
+    int pageWords = 0; // uint16 words per page (mem-per-frame / 2)
+    pmr::memory_resource* resource; // Page buffers are never freed individually
+    pmr::vector<uint16_t*> pages;
+    pmr::vector<SharedPage*> shared; // Non-null where pages[vpn] points into a SharedPage
+
+    MemoryImage(int wordsPerPage, pmr::memory_resource* res) : pageWords(wordsPerPage), resource(res), pages(res), shared(res) {}
+    MemoryImage(MemoryImage&&) = default; // Leaves the source without references
+    MemoryImage& operator=(MemoryImage&&) = delete;
+
+    ~MemoryImage() {
+        for (SharedPage* page : shared) dropShared(page);
+    }
+
+    /**
+     * Sizes the page tables up front. The arena never frees, so letting them
+     * grow one page at a time would strand every smaller copy.
+     */
+    void reserve(int pageCount) {
+        pages.reserve(pageCount);
+        shared.reserve(pageCount);
+    }
+
+    bool isShared(int vpn) const {
+        return vpn >= 0 && vpn < static_cast<int>(shared.size()) && shared[vpn];
+    }
+
+    /**
+     * Makes every page this image holds shared copy-on-write with child,
+     * which must be empty. A page is copied once, the first time it is
+     * shared; later forks only take references.
+     */
+    void shareWith(MemoryImage& child) {
+        shared.resize(pages.size(), nullptr);
+        child.pages.assign(pages.size(), nullptr);
+        child.shared.assign(pages.size(), nullptr);
+        for (size_t vpn = 0; vpn < pages.size(); ++vpn) {
+            if (!pages[vpn]) continue;
+            if (!shared[vpn]) {
+                SharedPage* page = new SharedPage;
+                page->words.assign(pages[vpn], pages[vpn] + pageWords);
+                shared[vpn] = page;
+                pages[vpn] = page->words.data();
+            }
+            shared[vpn]->refs++;
+            child.pages[vpn] = pages[vpn];
+            child.shared[vpn] = shared[vpn];
+        }
+    }
+
+    const uint16_t* findPage(int vpn) const {
+        if (vpn < 0 || vpn >= static_cast<int>(pages.size())) return nullptr;
+        return pages[vpn];
+    }
+
+    uint16_t* touchPage(int vpn) {
+        if (vpn >= static_cast<int>(pages.size())) pages.resize(vpn + 1, nullptr);
+        if (!pages[vpn] || isShared(vpn)) {
+            void* buffer = resource->allocate(pageWords * sizeof(uint16_t), alignof(uint16_t));
+            if (isShared(vpn)) {
+                memcpy(buffer, pages[vpn], pageWords * sizeof(uint16_t));
+                dropShared(shared[vpn]);
+                shared[vpn] = nullptr;
+            }
+            else {
+                memset(buffer, 0, pageWords * sizeof(uint16_t));
+            }
+            pages[vpn] = static_cast<uint16_t*>(buffer);
+        }
+        return pages[vpn];
+    }
+
+    uint16_t read(int addr) const {
+        int word = addr / 2;
+        const uint16_t* page = findPage(word / pageWords);
+        return page ? page[word % pageWords] : 0;
+    }
+
+    void write(int addr, uint16_t value) {
+        int word = addr / 2;
+        touchPage(word / pageWords)[word % pageWords] = value;
+    }
+
+private:
+    static void dropShared(SharedPage* page) {
+        if (page && page->refs.fetch_sub(1) == 1) delete page;
+    }
+};
+
+/**
+ * A swap-in started by faultInPage while page-fault-io is asynchronous. The
+ * process is parked until every run of pages has been read into pages; the
+ * core that resumes it copies them into the memory image (finishPageIn).
+ */
+struct PendingPageIn {
+    int faultPage = -1;
+    vector<int> vpns; // Sorted; faultPage and any prefetched pages
+    vector<vector<uint16_t>> pages; // Read buffers, one slot per vpn
+    int runsLeft = 0;    // io_uring reads not yet completed
+    size_t bytesLeft = 0; // Bytes those reads must still deliver; a short read leaves some
+    bool failed = false; // The memory image still holds the data, so a failed read only costs a refault
+    chrono::steady_clock::time_point submittedAt{};
+};
+
+/**
+ * Defines the process structure. A process belongs to one thread at a time (its
+ * creator, the CPU worker running it, or pageFaultService while it is parked)
+ * and changes hands through the queue mutexes, so fields such as isFinished and
+ * currentInstructionIndex need no lock of their own. Other threads read status.
+ */
+struct Process {
+    // Backs symbolSlots, memory, pageTable and chunkPool; declared first so it outlives them.
+    // Freed in one piece when the process is retired. It never reuses freed blocks, so
+    // containers in it are reserved to their final size rather than left to grow.
+    unique_ptr<pmr::monotonic_buffer_resource> arena;
+    // Backs the instruction chunk and its strings. Each chunk frees the previous one's
+    // strings back to the pool, so the arena only grows to the largest chunk.
+    unique_ptr<pmr::unsynchronized_pool_resource> chunkPool;
+
+    string name;
+    int pid;
+    time_t startTime;
+    time_t endTime;
+    int core; // Core that is executing or executed the process
+    int tasksCompleted;
+    int totalTasks; // Total number of instructions to execute
+    bool isFinished;
+    shared_ptr<const ProgramImage> program; // Shared program; null for streamed programs
+    pmr::vector<ProcessInstruction> instructions; // Current chunk of a streamed program
+
+    // Symbol table: 32 uint16 variables occupying the first 64 bytes of page 0.
+    // Instructions address it by slot; declaredSlots has bit i set once slot i is declared.
+    uint16_t symbolTable[SYMBOL_TABLE_SLOTS] = {};
+    uint32_t declaredSlots = 0;
+    pmr::unordered_map<pmr::string, int> symbolSlots; // Name -> slot, only used while resolving new instructions
+
+    // === [NEW] === Memory and violation tracking members
+    int memorySize; // Process-specific memory allocation
+    MemoryImage memory; // Emulated memory space (the symbol table segment lives in symbolTable)
+    // Held to change memory or symbolTable, and by an evicting core copying them out. The owning
+    // process reads both without it. Taken after frameTableMutex, never before.
+    unique_ptr<mutex> memoryMutex = make_unique<mutex>();
+    bool has_violation;
+    string violation_address;
+
+    int currentInstructionIndex = 0; // track instruction being executed
+
+    pmr::unordered_map<int, PageTableEntry> pageTable; // For page allocator
+
+    // Sub-second timestamps for the latency histograms (startTime/endTime are for display)
+    chrono::steady_clock::time_point startClock{};
+    chrono::steady_clock::time_point endClock{};
+    chrono::steady_clock::time_point readyEnqueuedAt{};     // Last push onto ready_queue
+    chrono::steady_clock::time_point admissionEnqueuedAt{}; // Push onto waiting_for_memory_queue
+
+    shared_ptr<ProcessStatus> status; // Published copy of the fields above for the reporters
+
+    // Streamed programs: instructions holds only the current chunk, which starts at
+    // program index chunkBase; the generator produces the rest on demand.
+    shared_ptr<class WorkloadGenerator> generator; // Null for fully materialized programs
+    int instructionsToGenerate = 0;
+    int chunkBase = 0;
+
+    int swapBase = -1; // First swap file slot of this process (-1 = never swapped out)
+    unique_ptr<PendingPageIn> pendingPageIn; // Set while blocked on I/O
+    // Set by finishPageIn for the instruction that reruns. Its other faults read synchronously,
+    // since parking again could let its second page evict the first on every resume.
+    bool resumedFromPageIn = false;
+#ifdef AJEL_HAVE_IO_URING
+    vector<iovec> pendingIovecs; // Read targets of pendingPageIn, referenced by the kernel until it completes
+#endif
+
+    // Fault pattern seen by the prefetcher (READ/WRITE faults only)
+    int lastFaultPage = -1;
+    int faultStride = 0;
+    int strideRun = 0; // Consecutive faults that repeated faultStride
+
+    Process(const string& processName, int memSize, int id = -1) :
+        arena(make_unique<pmr::monotonic_buffer_resource>(PROCESS_ARENA_INITIAL_BYTES)),
+        chunkPool(make_unique<pmr::unsynchronized_pool_resource>(arena.get())),
+        name(processName), memorySize(memSize), pid(id), startTime(0), endTime(0), core(-1),
+        tasksCompleted(0), totalTasks(0), isFinished(false), instructions(chunkPool.get()),
+        symbolSlots(arena.get()), memory(max(1, systemConfig.mem_per_frame / 2), arena.get()),
+        has_violation(false), currentInstructionIndex(0), pageTable(arena.get()),
+        status(make_shared<ProcessStatus>(processName, memSize, id)) {
+        symbolSlots.reserve(SYMBOL_TABLE_SLOTS);
+        memory.reserve(memSize / max(1, systemConfig.mem_per_frame));
+    }
+
+    // === [MODIFIED] === Updated default constructor
+    Process()
+        : arena(make_unique<pmr::monotonic_buffer_resource>(PROCESS_ARENA_INITIAL_BYTES)),
+        chunkPool(make_unique<pmr::unsynchronized_pool_resource>(arena.get())),
+        name("unnamed"), memorySize(0), pid(-1), startTime(0), endTime(0), core(-1),
+        tasksCompleted(0), totalTasks(0), isFinished(false), instructions(chunkPool.get()),
+        symbolSlots(arena.get()), memory(max(1, systemConfig.mem_per_frame / 2), arena.get()),
+        has_violation(false), currentInstructionIndex(0), pageTable(arena.get()),
+        status(make_shared<ProcessStatus>("unnamed", 0, -1)) {
+        symbolSlots.reserve(SYMBOL_TABLE_SLOTS);
+    }
+
+
+    /**
+     * Publishes the current progress to status. Only the thread that owns
+     * the process (creator or the worker running it) may call this.
+     */
+    void publishStatus() const {
+        ProcessStatusView::State state = ProcessStatusView::WAITING;
+        if (isFinished) state = has_violation ? ProcessStatusView::VIOLATION : ProcessStatusView::FINISHED;
+        else if (pendingPageIn) state = ProcessStatusView::BLOCKED;
+        else if (startTime != 0) state = ProcessStatusView::RUNNING;
+        status->publish(state, core, tasksCompleted, totalTasks, startTime, endTime, violation_address);
+    }
+
+};
+
+/**
+ * Percentile summary of a LatencyHistogram, in microseconds.
+ */
+struct LatencySummary {
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t min = 0;
+    double mean = 0.0;
+    uint64_t p50 = 0;
+    uint64_t p90 = 0;
+    uint64_t p99 = 0;
+    uint64_t p999 = 0;
+    uint64_t max = 0;
+};
+
+/**
+ * Point-in-time view of the system counters. Built only from atomics, so
+ * capturing one never blocks the scheduler or the CPU workers.
+ */
+struct MetricsSnapshot {
+    time_t timestamp = 0;
+
+    long long totalMemBytes = 0;
+    long long usedMemBytes = 0;
+
+    int totalFrames = 0;
+    int usedFrames = 0;
+    int dirtyFrames = 0;
+    int frameSize = 0;
+
+    int totalCores = 0;
+    int busyCores = 0;
+    vector<long long> coreBusyMicros; // Per core
+    int totalCpuTicks = 0;
+    int activeCpuTicks = 0;
+    int idleCpuTicks = 0;
+
+    int pageFaults = 0;
+    int pagesPagedIn = 0;
+    int zeroFillFaults = 0;
+    int pagesPagedOut = 0;
+    int pagesPrefetched = 0;
+    int prefetchHits = 0;
+    int swapReadCalls = 0;
+    int swapWriteCalls = 0;
+    int asyncPageIns = 0;
+    int pagesCompressed = 0;
+    int compressedPoolHits = 0;
+    int pagesSpilled = 0;
+    int compressedPoolPages = 0;
+    long long compressedPoolBytes = 0;
+    long long compressedPoolCapacity = 0;
+    int cowFaults = 0;
+    int cowPageCopies = 0;
+    int forkedProcs = 0;
+    int programImages = 0;
+    int programCacheHits = 0;
+    int programCacheMisses = 0;
+
+    int runningProcs = 0;
+    int blockedProcs = 0; // Included in runningProcs
+    int waitingProcs = 0;
+    int finishedProcs = 0;
+    int violatedProcs = 0;
+    int totalProcs = 0;
+
+    int readyQueueDepth = 0;
+    int waitingQueueDepth = 0;
+    long long instructionsExecuted = 0;
+
+    LatencySummary readyQueueWait;
+    LatencySummary admissionWait;
+    LatencySummary turnaround;
+    LatencySummary pageInWait;
+    LatencySummary instructionExec[INSTRUCTION_TYPE_COUNT];
+};
+
+// =================== Structures - END =================== //
+
+
+// ===================== Classes ===================== //
+
+/**
+ * Per-process workload generator: draws instruction types from the configured
+ * mix and READ/WRITE addresses from the configured distribution. Each instance
+ * owns its PRNG stream, so generator threads never share state.
+ */
+class WorkloadGenerator {
+private:
+    const WorkloadProfile& profile;
+    FastRandom rng;
+    vector<pair<int, ProcessInstruction::Type>> cumulativeMix; // <upper bound, type>
+    int totalWeight = 0;
+    int sequentialCursor = 0; // Next word for the sequential distribution
+    int strideCursor = 0;     // Next byte offset for the stride distribution
+    int hotRegionStart = -1;  // First byte of the hot region (chosen on first use)
+    int phaseAccesses = 0;    // Accesses made in the current phase
+    int phaseBasePage = 0;    // First page of the current working set
+
+    // Zipf constants for the current address space (rejection-inversion sampling)
+    int zipfWords = 0;
+    double zipfHIntegralX1 = 0, zipfHIntegralN = 0, zipfS = 0;
+
+    static double helper1(double x) { return fabs(x) > 1e-8 ? log1p(x) / x : 1 - x * (0.5 - x * (1.0 / 3 - 0.25 * x)); }
+    static double helper2(double x) { return fabs(x) > 1e-8 ? expm1(x) / x : 1 + x * 0.5 * (1 + x * (1.0 / 3) * (1 + 0.25 * x)); }
+    double zipfH(double x) const { return exp(-profile.zipf_exponent * log(x)); }
+    double zipfHIntegral(double x) const {
+        double logX = log(x);
+        return helper2((1 - profile.zipf_exponent) * logX) * logX;
+    }
+    double zipfHIntegralInverse(double x) const {
+        double t = x * (1 - profile.zipf_exponent);
+        if (t < -1) t = -1;
+        return exp(helper1(t) * x);
+    }
+
+    void prepareZipf(int words) {
+        zipfWords = words;
+        zipfHIntegralX1 = zipfHIntegral(1.5) - 1;
+        zipfHIntegralN = zipfHIntegral(words + 0.5);
+        zipfS = 2 - zipfHIntegralInverse(zipfHIntegral(2.5) - zipfH(2));
+    }
+
+    // Zipf rank in [1, words] (Hormann & Derflinger rejection-inversion, O(1) per sample)
+    int zipfRank(int words) {
+        if (words != zipfWords) prepareZipf(words);
+        while (true) {
+            double u = zipfHIntegralN + rng.unit() * (zipfHIntegralX1 - zipfHIntegralN);
+            double x = zipfHIntegralInverse(u);
+            int k = static_cast<int>(x + 0.5);
+            if (k < 1) k = 1;
+            else if (k > words) k = words;
+            if (k - x <= zipfS || u >= zipfHIntegral(k + 0.5) - zipfH(k)) return k;
+        }
+    }
+
+public:
+    WorkloadGenerator(const WorkloadProfile& workloadProfile, const FastRandom& stream)
+        : profile(workloadProfile), rng(stream) {
+        pair<int, ProcessInstruction::Type> weights[] = {
+            { profile.mix_print, ProcessInstruction::PRINT },
+            { profile.mix_declare, ProcessInstruction::DECLARE },
+            { profile.mix_add, ProcessInstruction::ADD },
+            { profile.mix_subtract, ProcessInstruction::SUBTRACT },
+            { profile.mix_read, ProcessInstruction::READ },
+            { profile.mix_write, ProcessInstruction::WRITE }
+        };
+        for (const auto& [weight, type] : weights) {
+            if (weight <= 0) continue;
+            totalWeight += weight;
+            cumulativeMix.emplace_back(totalWeight, type);
+        }
+    }
+
+    // Uniform integer in [0, bound)
+    int below(int bound) {
+        return rng.below(bound);
+    }
+
+    ProcessInstruction::Type nextType() {
+        int pick = rng.below(totalWeight);
+        for (const auto& [upper, type] : cumulativeMix) {
+            if (pick < upper) return type;
+        }
+        return cumulativeMix.back().second;
+    }
+
+    /**
+     * Next READ/WRITE byte address inside a process of memorySize bytes.
+     */
+    int nextAddress(int memorySize) {
+        if (memorySize <= 0) return 0;
+        int words = memorySize / 2;
+        if (words < 1) return rng.below(memorySize);
+
+        switch (profile.address_distribution) {
+        case WorkloadProfile::SEQUENTIAL: {
+            int word = sequentialCursor++ % words;
+            return word * 2;
+        }
+        case WorkloadProfile::ZIPF: {
+            // Scatter ranks with an odd multiplier so the hot words are not all
+            // on the first page (a bijection when words is a power of two)
+            long long rank = zipfRank(words) - 1;
+            int word = static_cast<int>((rank * 2654435761LL) % words);
+            return word * 2;
+        }
+        case WorkloadProfile::STRIDE: {
+            int addr = strideCursor % memorySize;
+            strideCursor = (strideCursor + profile.address_stride) % memorySize;
+            return addr;
+        }
+        case WorkloadProfile::HOT_COLD: {
+            int hotSize = static_cast<int>(memorySize * profile.hot_fraction);
+            if (hotSize < 1) hotSize = 1;
+            if (hotRegionStart < 0) {
+                // Place the hot region on a page boundary, once per process
+                int pageSize = systemConfig.mem_per_frame > 0 ? systemConfig.mem_per_frame : memorySize;
+                int slots = (memorySize - hotSize) / pageSize + 1;
+                hotRegionStart = rng.below(slots) * pageSize;
+                if (hotRegionStart + hotSize > memorySize) hotRegionStart = memorySize - hotSize;
+            }
+            if (hotSize >= memorySize || rng.unit() < profile.hot_probability) {
+                return hotRegionStart + rng.below(hotSize);
+            }
+            // Cold access: anywhere outside the hot region
+            int coldAddr = rng.below(memorySize - hotSize);
+            return coldAddr < hotRegionStart ? coldAddr : coldAddr + hotSize;
+        }
+        case WorkloadProfile::PHASED: {
+            int pageSize = systemConfig.mem_per_frame > 0 ? systemConfig.mem_per_frame : memorySize;
+            int totalPages = (memorySize + pageSize - 1) / pageSize;
+            int setPages = profile.working_set_pages < totalPages ? profile.working_set_pages : totalPages;
+            if (phaseAccesses++ % profile.phase_length == 0) {
+                // New phase: move the working set to a random run of pages
+                phaseBasePage = rng.below(totalPages - setPages + 1);
+            }
+            int setStart = phaseBasePage * pageSize;
+            int setSize = setPages * pageSize;
+            if (setStart + setSize > memorySize) setSize = memorySize - setStart;
+            return setStart + rng.below(setSize);
+        }
+        case WorkloadProfile::UNIFORM:
+        default:
+            return rng.below(memorySize);
+        }
+    }
+};
+
+/**
+ * The backing store: a binary file of fixed-size page slots, open from
+ * initialize until exit. A process gets a contiguous run of slots (one per
+ * virtual page) the first time it swaps out, so neighboring pages sit next to
+ * each other in the file and each run of them moves with one preadv/pwritev.
+ */
+class SwapDevice {
+public:
+    static const int MAX_IOVECS = 64; // Pages per vectored call
+
+    bool open(const string& path, int bytesPerSlot) {
+        close();
+#ifdef _WIN32
+        fd = _open(path.c_str(), _O_RDWR | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+#endif
+        slotBytes = bytesPerSlot;
+        nextSlot = 0;
+        freeRanges.clear();
+        return fd >= 0;
+    }
+
+    void close() {
+        if (fd < 0) return;
+#ifdef _WIN32
+        _close(fd);
+#else
+        ::close(fd);
+#endif
+        fd = -1;
+    }
+
+    bool isOpen() const { return fd >= 0; }
+    int slotWords() const { return slotBytes / 2; }
+    int fileDescriptor() const { return fd; }
+
+    long long slotOffset(int base, int vpn) const {
+        return static_cast<long long>(base + vpn) * slotBytes;
+    }
+
+    /**
+     * Splits sorted vpns into runs of consecutive pages, at most MAX_IOVECS
+     * long, as (first index, page count). Each run is one call.
+     */
+    static vector<pair<size_t, size_t>> pageRuns(const vector<int>& vpns) {
+        vector<pair<size_t, size_t>> runs;
+        size_t first = 0;
+        while (first < vpns.size()) {
+            size_t last = first + 1;
+            while (last < vpns.size() && vpns[last] == vpns[last - 1] + 1 && last - first < MAX_IOVECS) last++;
+            runs.emplace_back(first, last - first);
+            first = last;
+        }
+        return runs;
+    }
+
+    /**
+     * Returns the first slot of the process's range, reserving numPages slots on first use.
+     */
+    int reserve(Process& process, int numPages) {
+        if (process.swapBase >= 0) return process.swapBase;
+        lock_guard<mutex> lock(allocMutex);
+        for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it) {
+            if (it->second >= numPages) {
+                process.swapBase = it->first;
+                it->first += numPages;
+                it->second -= numPages;
+                if (it->second == 0) freeRanges.erase(it);
+                return process.swapBase;
+            }
+        }
+        process.swapBase = nextSlot;
+        nextSlot += numPages;
+        return process.swapBase;
+    }
+
+    /**
+     * Returns a retired process's slots for reuse, merging them with any free
+     * neighbors so later, larger processes can still get one contiguous run.
+     */
+    void release(Process& process, int numPages) {
+        if (process.swapBase < 0) return;
+        lock_guard<mutex> lock(allocMutex);
+        pair<int, int> range(process.swapBase, numPages);
+        process.swapBase = -1;
+        auto next = lower_bound(freeRanges.begin(), freeRanges.end(), range);
+        if (next != freeRanges.end() && range.first + range.second == next->first) {
+            range.second += next->second;
+            next = freeRanges.erase(next);
+        }
+        if (next != freeRanges.begin() && prev(next)->first + prev(next)->second == range.first) {
+            prev(next)->second += range.second;
+        }
+        else {
+            freeRanges.insert(next, range);
+        }
+        // A free range at the end of the file goes back to the bump allocator
+        if (!freeRanges.empty() && freeRanges.back().first + freeRanges.back().second == nextSlot) {
+            nextSlot = freeRanges.back().first;
+            freeRanges.pop_back();
+        }
+    }
+
+    /**
+     * Writes/reads pages[i] (slotWords() words each) to/from slot base + vpns[i].
+     * vpns must be sorted; each run of consecutive pages is one call, repeated
+     * for the remainder if the kernel moves fewer bytes than asked.
+     * Returns the number of calls issued, or -1 on an I/O error or end of file.
+     */
+    int writePages(int base, const vector<int>& vpns, vector<vector<uint16_t>>& pages) {
+        return transfer(true, base, vpns, pages);
+    }
+
+    int readPages(int base, const vector<int>& vpns, vector<vector<uint16_t>>& pages) {
+        return transfer(false, base, vpns, pages);
+    }
+
+private:
+    int fd = -1;
+    int slotBytes = 0;
+    mutex allocMutex;
+    int nextSlot = 0;
+    vector<pair<int, int>> freeRanges; // (first slot, slot count), sorted and never adjacent
+#ifdef _WIN32
+    mutex seekMutex; // _lseeki64 + _read/_write share the file position
+#endif
+
+    int transfer(bool write, int base, const vector<int>& vpns, vector<vector<uint16_t>>& pages) {
+        if (fd < 0) return -1;
+        int calls = 0;
+        for (auto [first, count] : pageRuns(vpns)) {
+            long long offset = slotOffset(base, vpns[first]);
+            size_t bytes = count * slotBytes;
+#ifdef _WIN32
+            vector<uint16_t> run(count * slotWords());
+            if (write) {
+                for (size_t i = 0; i < count; ++i) memcpy(&run[i * slotWords()], pages[first + i].data(), slotBytes);
+            }
+            {
+                lock_guard<mutex> lock(seekMutex);
+                if (_lseeki64(fd, offset, SEEK_SET) < 0) return -1;
+                char* cursor = reinterpret_cast<char*>(run.data());
+                for (size_t moved = 0; moved < bytes; calls++) {
+                    int done = write ? _write(fd, cursor + moved, static_cast<unsigned>(bytes - moved))
+                        : _read(fd, cursor + moved, static_cast<unsigned>(bytes - moved));
+                    if (done <= 0) return -1; // 0: read past the end of the file
+                    moved += done;
+                }
+            }
+            if (!write) {
+                for (size_t i = 0; i < count; ++i) memcpy(pages[first + i].data(), &run[i * slotWords()], slotBytes);
+            }
+#else
+            iovec iov[MAX_IOVECS];
+            for (size_t i = 0; i < count; ++i) {
+                iov[i].iov_base = pages[first + i].data();
+                iov[i].iov_len = slotBytes;
+            }
+            size_t next = 0; // First iovec not yet fully transferred
+            for (size_t moved = 0; moved < bytes; calls++) {
+                ssize_t done = write ? pwritev(fd, iov + next, static_cast<int>(count - next), offset + moved)
+                    : preadv(fd, iov + next, static_cast<int>(count - next), offset + moved);
+                if (done < 0 && errno == EINTR) continue;
+                if (done <= 0) return -1; // 0: read past the end of the file
+                moved += done;
+                // Skip the pages that are done and trim the one that was cut short
+                while (next < count && static_cast<size_t>(done) >= iov[next].iov_len) {
+                    done -= iov[next].iov_len;
+                    next++;
+                }
+                if (done > 0) {
+                    iov[next].iov_base = static_cast<char*>(iov[next].iov_base) + done;
+                    iov[next].iov_len -= done;
+                }
+            }
+#endif
+        }
+        return calls;
+    }
+};
+
+extern SwapDevice swapDevice; // Opened by initializeSystem()
+
+/**
+ * Compressed RAM tier in front of the swap file (zswap-style). Evicted pages
+ * are stored run-length encoded; most emulated pages are mostly zero and
+ * shrink to a few words. When the pool is full the least recently used
+ * entries move to a spill queue, and a spiller thread writes them to the
+ * swap file without holding any lock; they still serve loads until written.
+ * A stored entry is the page's swap copy until it is overwritten, spilled or
+ * its process retires, so clean pages can be evicted again without another store.
+ */
+class CompressedSwapPool {
+public:
+    ~CompressedSwapPool() { stop(); }
+
+    /**
+     * Sizes the pool (0 turns it off), dropping every entry, and starts the spiller.
+     */
+    void configure(size_t capacityBytes) {
+        stop();
+        lock_guard<mutex> lock(poolMutex);
+        capacity = capacityBytes;
+        used = 0;
+        spillingBytes = 0;
+        lru.clear();
+        spillQueue.clear();
+        index.clear();
+        compressedPoolPages = 0;
+        compressedPoolBytes = 0;
+        stopping = false;
+        if (capacity > 0) spiller = thread(&CompressedSwapPool::spillerMain, this);
+    }
+
+    /**
+     * Writes out the spill queue and stops the spiller.
+     */
+    void stop() {
+        if (!spiller.joinable()) return;
+        {
+            lock_guard<mutex> lock(poolMutex);
+            stopping = true;
+        }
+        spillCv.notify_all();
+        spiller.join();
+    }
+
+    bool isEnabled() const { return capacity > 0; }
+    size_t capacityBytes() const { return capacity; }
+
+    /**
+     * Stores a page, queueing the coldest entries for the spiller to make room.
+     * Returns false if the pool is off, the page does not compress to under a
+     * page, or the spill queue is too far behind to make room; any older entry
+     * for the page is dropped either way.
+     */
+    bool store(Process& process, int vpn, const vector<uint16_t>& words) {
+        if (!isEnabled()) return false;
+        vector<uint16_t> data;
+        encode(words, data);
+
+        lock_guard<mutex> lock(poolMutex);
+        erase(key(process.pid, vpn));
+        size_t bytes = data.size() * sizeof(uint16_t);
+        if (bytes >= words.size() * sizeof(uint16_t) || bytes > capacity) return false;
+
+        if (used + bytes > capacity) spillColdest(used + bytes - capacity);
+        if (used + bytes > capacity) return false;
+        lru.push_front(Entry{ &process, vpn, static_cast<int>(words.size()), move(data) });
+        index[key(process.pid, vpn)] = lru.begin();
+        used += bytes;
+        compressedPoolPages++;
+        compressedPoolBytes += static_cast<long long>(bytes);
+        pagesCompressed++;
+        return true;
+    }
+
+    /**
+     * Decompresses a stored page into words and marks it recently used.
+     */
+    bool load(const Process& process, int vpn, vector<uint16_t>& words) {
+        if (!isEnabled()) return false;
+        lock_guard<mutex> lock(poolMutex);
+        auto it = index.find(key(process.pid, vpn));
+        if (it == index.end()) return false;
+        if (!it->second->spilling) lru.splice(lru.begin(), lru, it->second);
+        decode(it->second->data, it->second->pageWords, words);
+        return true;
+    }
+
+    /**
+     * Drops the entries of a retiring process, first waiting out a spill
+     * write of its pages, which still refers to the process.
+     */
+    void release(const Process& process, int numPages) {
+        if (!isEnabled()) return;
+        unique_lock<mutex> lock(poolMutex);
+        spillCv.wait(lock, [&] { return writingProcess != &process; });
+        for (int vpn = 0; vpn < numPages; ++vpn) erase(key(process.pid, vpn));
+    }
+
+    /**
+     * Waits until the spiller is not writing pages of process, so a direct
+     * swap write of a newer copy cannot be overtaken by an older spilled one.
+     */
+    void waitForSpill(const Process& process) {
+        if (!isEnabled()) return;
+        unique_lock<mutex> lock(poolMutex);
+        spillCv.wait(lock, [&] { return writingProcess != &process; });
+    }
+
+    /**
+     * Word-level run-length encoding. A token with the top bit set is followed
+     * by one word repeated (token & 0x7FFF) times; otherwise it is followed by
+     * that many literal words.
+     */
+    static void encode(const vector<uint16_t>& words, vector<uint16_t>& out) {
+        const size_t MAX_RUN = 0x7FFF;
+        out.clear();
+        size_t i = 0, n = words.size();
+        while (i < n) {
+            size_t run = 1;
+            while (i + run < n && run < MAX_RUN && words[i + run] == words[i]) run++;
+            if (run >= 3) {
+                out.push_back(static_cast<uint16_t>(0x8000 | run));
+                out.push_back(words[i]);
+                i += run;
+                continue;
+            }
+            // Literals up to the next run of three
+            size_t start = i, tokenPos = out.size();
+            out.push_back(0);
+            while (i < n && i - start < MAX_RUN &&
+                !(i + 2 < n && words[i] == words[i + 1] && words[i] == words[i + 2])) {
+                out.push_back(words[i++]);
+            }
+            out[tokenPos] = static_cast<uint16_t>(i - start);
+        }
+    }
+
+    static void decode(const vector<uint16_t>& data, int pageWords, vector<uint16_t>& words) {
+        words.assign(pageWords, 0);
+        size_t pos = 0, out = 0;
+        while (pos < data.size() && out < words.size()) {
+            uint16_t token = data[pos++];
+            size_t count = token & 0x7FFF;
+            if (token & 0x8000) {
+                uint16_t value = pos < data.size() ? data[pos++] : 0;
+                for (size_t k = 0; k < count && out < words.size(); ++k) words[out++] = value;
+            }
+            else {
+                for (size_t k = 0; k < count && pos < data.size() && out < words.size(); ++k) words[out++] = data[pos++];
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        Process* process;
+        int vpn;
+        int pageWords;
+        vector<uint16_t> data;
+        bool spilling = false; // In spillQueue rather than lru
+        bool writing = false;  // Part of the batch the spiller is writing
+        int swapBase = -1;     // Process's swap slots, reserved when queued for spilling
+    };
+
+    size_t capacity = 0;
+    size_t used = 0;          // Bytes of the entries in lru
+    size_t spillingBytes = 0; // Bytes of the entries in spillQueue
+    list<Entry> lru;        // Most recently stored or loaded first
+    list<Entry> spillQueue; // Oldest first; unlinked from lru but still found through index
+    unordered_map<uint64_t, list<Entry>::iterator> index; // Entries of both lists
+    mutex poolMutex; // Never held across I/O; taken after frameTableMutex
+    condition_variable spillCv; // New spills for the spiller; finished writes for release/waitForSpill
+    thread spiller;
+    bool stopping = false;
+    const Process* writingProcess = nullptr; // Owner of the batch being written, if any
+
+    static uint64_t key(int pid, int vpn) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(pid)) << 32) | static_cast<uint32_t>(vpn);
+    }
+
+    void erase(uint64_t entryKey) {
+        auto it = index.find(entryKey);
+        if (it == index.end()) return;
+        size_t bytes = it->second->data.size() * sizeof(uint16_t);
+        if (it->second->spilling) {
+            spillingBytes -= bytes;
+            spillQueue.erase(it->second);
+        }
+        else {
+            used -= bytes;
+            compressedPoolPages--;
+            compressedPoolBytes -= static_cast<long long>(bytes);
+            lru.erase(it->second);
+        }
+        index.erase(it);
+    }
+
+    /**
+     * Moves the least recently used entries to the spill queue until at least
+     * needed bytes are free, or until the queue holds a pool's worth of data.
+     * Their swap slots are reserved here, where the caller holds frameTableMutex
+     * like every other reserve.
+     */
+    void spillColdest(size_t needed) {
+        size_t freed = 0;
+        while (freed < needed && !lru.empty() && spillingBytes < capacity) {
+            auto it = prev(lru.end());
+            size_t bytes = it->data.size() * sizeof(uint16_t);
+            it->spilling = true;
+            it->swapBase = swapDevice.reserve(*it->process, it->process->memorySize / systemConfig.mem_per_frame);
+            spillQueue.splice(spillQueue.end(), lru, it);
+            used -= bytes;
+            spillingBytes += bytes;
+            compressedPoolPages--;
+            compressedPoolBytes -= static_cast<long long>(bytes);
+            freed += bytes;
+        }
+        if (freed > 0) spillCv.notify_all();
+    }
+
+    /**
+     * Spiller thread: writes the queued entries of one process at a time with
+     * poolMutex released, then drops them from the pool. An entry stored again
+     * meanwhile is left alone, since the pool copy is newer than the write.
+     */
+    void spillerMain() {
+        unique_lock<mutex> lock(poolMutex);
+        for (;;) {
+            spillCv.wait(lock, [this] { return stopping || !spillQueue.empty(); });
+            if (spillQueue.empty()) return; // Stopping and drained
+
+            Process* process = spillQueue.front().process;
+            int base = spillQueue.front().swapBase;
+            vector<pair<int, vector<uint16_t>>> pages;
+            for (Entry& entry : spillQueue) {
+                if (entry.process != process) continue;
+                entry.writing = true;
+                pages.emplace_back(entry.vpn, vector<uint16_t>());
+                decode(entry.data, entry.pageWords, pages.back().second);
+                pages.back().second.resize(swapDevice.slotWords(), 0);
+            }
+            writingProcess = process;
+            lock.unlock();
+
+            sort(pages.begin(), pages.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+            vector<int> vpns;
+            vector<vector<uint16_t>> buffers;
+            for (auto& [vpn, words] : pages) {
+                vpns.push_back(vpn);
+                buffers.push_back(move(words));
+            }
+            int calls = swapDevice.writePages(base, vpns, buffers);
+
+            lock.lock();
+            writingProcess = nullptr;
+            for (int vpn : vpns) {
+                auto it = index.find(key(process->pid, vpn));
+                if (it == index.end() || !it->second->writing) continue; // Superseded while written
+                erase(it->first);
+                // Without the pool entry a failed write leaves no swap copy; the page is
+                // reloaded from the memory image, as if never written out
+                if (calls < 0) process->pageTable.find(vpn)->second.hasSwapCopy = false;
+            }
+            if (calls >= 0) {
+                swapWriteCalls += calls;
+                pagesSpilled += static_cast<int>(vpns.size()); // Not pageReplacements: the page was paged out when it was compressed
+            }
+            spillCv.notify_all();
+        }
+    }
+};
+
+extern CompressedSwapPool compressedPool; // Sized by initializeSystem()
+
+#ifdef AJEL_HAVE_IO_URING
+/**
+ * Minimal io_uring instance driven through the raw syscalls: any thread may
+ * submit, one thread reaps completions.
+ */
+class IoUring {
+public:
+    ~IoUring() { close(); }
+
+    bool open(unsigned entries) {
+        io_uring_params params{};
+        int fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (fd < 0) return false;
+        ringFd = fd;
+
+        bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        sqRingBytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingBytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        if (singleMmap) sqRingBytes = cqRingBytes = max(sqRingBytes, cqRingBytes);
+        sqesBytes = params.sq_entries * sizeof(io_uring_sqe);
+
+        sqRing = mmap(nullptr, sqRingBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        cqRing = singleMmap ? sqRing
+            : mmap(nullptr, cqRingBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        void* sqeArea = mmap(nullptr, sqesBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (sqRing == MAP_FAILED || cqRing == MAP_FAILED || sqeArea == MAP_FAILED) {
+            if (sqeArea != MAP_FAILED) munmap(sqeArea, sqesBytes);
+            if (cqRing != MAP_FAILED && cqRing != sqRing) munmap(cqRing, cqRingBytes);
+            if (sqRing != MAP_FAILED) munmap(sqRing, sqRingBytes);
+            sqRing = cqRing = nullptr;
+            ::close(ringFd);
+            ringFd = -1;
+            return false;
+        }
+
+        char* sq = static_cast<char*>(sqRing);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sqes = static_cast<io_uring_sqe*>(sqeArea);
+        sqEntries = params.sq_entries;
+
+        char* cq = static_cast<char*>(cqRing);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        cqEntries = params.cq_entries;
+        return true;
+    }
+
+    void close() {
+        if (ringFd < 0) return;
+        munmap(sqes, sqesBytes);
+        if (cqRing != sqRing) munmap(cqRing, cqRingBytes);
+        munmap(sqRing, sqRingBytes);
+        ::close(ringFd);
+        ringFd = -1;
+    }
+
+    bool isOpen() const { return ringFd >= 0; }
+    unsigned completionCapacity() const { return cqEntries; }
+
+    static void prepareReadv(io_uring_sqe& sqe, int fd, const iovec* iov, unsigned count, long long offset, uint64_t userData) {
+        memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READV;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<uint64_t>(iov);
+        sqe.len = count;
+        sqe.off = static_cast<uint64_t>(offset);
+        sqe.user_data = userData;
+    }
+
+    static void prepareNop(io_uring_sqe& sqe, uint64_t userData) {
+        memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_NOP;
+        sqe.user_data = userData;
+    }
+
+    /**
+     * Queues and submits the entries together. Returns false, queuing
+     * nothing, if the submission queue lacks room for all of them.
+     */
+    bool submit(const vector<io_uring_sqe>& batch) {
+        lock_guard<mutex> lock(submitMutex);
+        unsigned tail = *sqTail;
+        unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+        if (batch.size() > sqEntries - (tail - head)) return false;
+
+        for (const io_uring_sqe& entry : batch) {
+            unsigned index = tail & sqMask;
+            sqes[index] = entry;
+            sqArray[index] = index;
+            tail++;
+        }
+        __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+
+        unsigned pending = static_cast<unsigned>(batch.size());
+        while (pending > 0) {
+            int done = static_cast<int>(syscall(__NR_io_uring_enter, ringFd, pending, 0, 0, nullptr, 0));
+            if (done < 0) {
+                if (errno != EINTR && errno != EAGAIN && errno != EBUSY) return false;
+                this_thread::yield();
+                continue;
+            }
+            pending -= static_cast<unsigned>(done);
+        }
+        return true;
+    }
+
+    /**
+     * Blocks until a completion is available. Only one thread may call this.
+     */
+    bool waitCompletion(uint64_t& userData, int& result) {
+        for (;;) {
+            unsigned head = *cqHead;
+            if (head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+                const io_uring_cqe& cqe = cqes[head & cqMask];
+                userData = cqe.user_data;
+                result = cqe.res;
+                __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+            int ret = static_cast<int>(syscall(__NR_io_uring_enter, ringFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+            if (ret < 0 && errno != EINTR) return false;
+        }
+    }
+
+private:
+    int ringFd = -1;
+    void* sqRing = nullptr;
+    void* cqRing = nullptr;
+    size_t sqRingBytes = 0, cqRingBytes = 0, sqesBytes = 0;
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqMask = 0, sqEntries = 0;
+    io_uring_sqe* sqes = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned cqMask = 0, cqEntries = 0;
+    io_uring_cqe* cqes = nullptr;
+    mutex submitMutex;
+};
+#endif
+
+/**
+ * Services swap-ins for processes parked by faultInPage, so the faulting core
+ * can run the next ready_queue entry. Reads go to io_uring when the kernel
+ * supports it and to a small thread pool otherwise; either way a finished
+ * read puts the process back on the ready_queue.
+ */
+class PageFaultService {
+public:
+    enum Backend { SYNC, IO_URING, THREADS };
+
+    /**
+     * Starts the backend named by mode (see SystemConfig::page_fault_io).
+     * Returns the backend actually started: io_uring falls back to threads.
+     */
+    Backend start(const string& mode, int threads) {
+        stop();
+        if (mode == "sync") return backend = SYNC;
+#ifdef AJEL_HAVE_IO_URING
+        if (mode != "threads" && ring.open(RING_ENTRIES)) {
+            stopping = false;
+            stopSeen = false;
+            reaper = thread(&PageFaultService::reaperMain, this);
+            return backend = IO_URING;
+        }
+#endif
+        stopping = false;
+        for (int i = 0; i < threads; ++i) {
+            workers.emplace_back(&PageFaultService::workerMain, this);
+        }
+        return backend = THREADS;
+    }
+
+    /**
+     * Waits for the reads in flight (their processes are requeued) and stops the backend.
+     */
+    void stop() {
+        if (backend == SYNC) return;
+        {
+            lock_guard<mutex> lock(requestMutex);
+            stopping = true;
+        }
+        requestCv.notify_all();
+#ifdef AJEL_HAVE_IO_URING
+        if (backend == IO_URING) {
+            vector<io_uring_sqe> nop(1);
+            IoUring::prepareNop(nop[0], 0);
+            while (!ring.submit(nop)) this_thread::yield();
+            reaper.join();
+            ring.close();
+        }
+#endif
+        for (auto& worker : workers) worker.join();
+        workers.clear();
+        backend = SYNC;
+    }
+
+    bool isAsync() const { return backend != SYNC; }
+
+    const char* backendName() const {
+        return backend == IO_URING ? "io_uring" : backend == THREADS ? "threads" : "sync";
+    }
+
+    /**
+     * Starts the read for process->pendingPageIn and parks the process. The
+     * caller must not touch the process afterwards; it is back on the
+     * ready_queue once the read completes.
+     */
+    void submit(Process* process) {
+        blockedOnIoCount++;
+        asyncPageIns++;
+        PendingPageIn& pending = *process->pendingPageIn;
+        pending.submittedAt = chrono::steady_clock::now();
+#ifdef AJEL_HAVE_IO_URING
+        if (backend == IO_URING) {
+            auto runs = SwapDevice::pageRuns(pending.vpns);
+            lock_guard<mutex> lock(requestMutex);
+            if (inFlight + runs.size() <= ring.completionCapacity()) {
+                pending.runsLeft = static_cast<int>(runs.size());
+                process->pendingIovecs.assign(pending.vpns.size(), iovec{});
+                vector<io_uring_sqe> batch(runs.size());
+                for (size_t r = 0; r < runs.size(); ++r) {
+                    auto [first, count] = runs[r];
+                    for (size_t i = first; i < first + count; ++i) {
+                        process->pendingIovecs[i].iov_base = pending.pages[i].data();
+                        process->pendingIovecs[i].iov_len = pending.pages[i].size() * sizeof(uint16_t);
+                        pending.bytesLeft += process->pendingIovecs[i].iov_len;
+                    }
+                    IoUring::prepareReadv(batch[r], swapDevice.fileDescriptor(), &process->pendingIovecs[first],
+                        static_cast<unsigned>(count), swapDevice.slotOffset(process->swapBase, pending.vpns[first]),
+                        reinterpret_cast<uint64_t>(process));
+                }
+                if (ring.submit(batch)) {
+                    inFlight += runs.size();
+                    swapReadCalls += static_cast<int>(runs.size());
+                    return;
+                }
+            }
+            // Ring full: read on this core rather than wait for a slot
+        }
+        else
+#endif
+        {
+            lock_guard<mutex> lock(requestMutex);
+            if (!stopping) {
+                requests.push(process);
+                requestCv.notify_one();
+                return;
+            }
+        }
+        readPages(*process);
+        complete(process);
+    }
+
+private:
+    static const unsigned RING_ENTRIES = 256;
+
+    Backend backend = SYNC;
+    mutex requestMutex;
+    bool stopping = false;
+
+    // threads backend
+    vector<thread> workers;
+    queue<Process*> requests;
+    condition_variable requestCv;
+
+#ifdef AJEL_HAVE_IO_URING
+    IoUring ring;
+    thread reaper;
+    size_t inFlight = 0; // Submitted reads without a completion (guarded by requestMutex)
+    bool stopSeen = false;
+#endif
+
+    static void readPages(Process& process) {
+        PendingPageIn& pending = *process.pendingPageIn;
+        int calls = swapDevice.readPages(process.swapBase, pending.vpns, pending.pages);
+        if (calls < 0) pending.failed = true;
+        else swapReadCalls += calls;
+    }
+
+    static void complete(Process* process) {
+        blockedOnIoCount--;
+        {
+            lock_guard<mutex> lock(queue_mutex);
+            process->readyEnqueuedAt = chrono::steady_clock::now();
+            ready_queue.push(process);
+            readyQueueDepth++;
+        }
+        scheduler_cv.notify_one();
+    }
+
+    void workerMain() {
+        for (;;) {
+            Process* process = nullptr;
+            {
+                unique_lock<mutex> lock(requestMutex);
+                requestCv.wait(lock, [this] { return stopping || !requests.empty(); });
+                if (requests.empty()) return; // Stopping and drained
+                process = requests.front();
+                requests.pop();
+            }
+            readPages(*process);
+            complete(process);
+        }
+    }
+
+#ifdef AJEL_HAVE_IO_URING
+    void reaperMain() {
+        for (;;) {
+            uint64_t userData = 0;
+            int result = 0;
+            if (!ring.waitCompletion(userData, result)) return;
+
+            Process* done = nullptr;
+            bool drained = false;
+            {
+                // Taking the lock the submitter held orders its writes to the request before ours
+                lock_guard<mutex> lock(requestMutex);
+                if (userData == 0) {
+                    stopSeen = true;
+                }
+                else {
+                    Process* process = reinterpret_cast<Process*>(userData);
+                    PendingPageIn& pending = *process->pendingPageIn;
+                    inFlight--;
+                    if (result < 0) pending.failed = true;
+                    else pending.bytesLeft -= static_cast<size_t>(result);
+                    if (--pending.runsLeft == 0) {
+                        // Runs are not resubmitted, so a short one fails the page-in like an error
+                        if (pending.bytesLeft != 0) pending.failed = true;
+                        done = process;
+                    }
+                }
+                // Completions arrive in any order, so the stop NOP may come before the last read
+                drained = stopSeen && inFlight == 0;
+            }
+            if (done) {
+                done->pendingIovecs.clear();
+                complete(done);
+            }
+            if (drained) return;
+        }
+    }
+#endif
+};
+
+extern PageFaultService pageFaultService; // Started by initializeSystem()
+
+/**
+ * Class for the screen object. Creates a new screen with a given name & a timestamp.
+ */
+class Screen {
+public:
+    string name;
+    int currentLine;
+    int totalLines;
+    int memorySize;  // Memory allocated to the process in bytes
+    string timestamp;
+
+private:
+    bool memoryViolation;        // Flag indicating if memory violation occurred
+    string violationTime;        // Time when violation occurred (HH:MM:SS format)
+    string violationAddress;     // Hex address that caused the violation
+
+public:
+    // Default constructor
+    Screen() : name(""), totalLines(100), currentLine(1), memorySize(64), memoryViolation(false) {}
+
+    // Updated constructor to include memory allocation
+    Screen(const string& name, int memorySize, int totalLines = 100)
+        : name(name), currentLine(1), totalLines(totalLines), memorySize(memorySize), memoryViolation(false) {
+        time_t now = time(0);
+        tm localtm;
+#ifdef _WIN32
+        localtime_s(&localtm, &now);
+#else
+        localtime_r(&now, &localtm);
+#endif
+        stringstream ss;
+        ss << put_time(&localtm, "%m/%d/%Y, %I:%M:%S %p");
+        timestamp = ss.str();
+    }
+
+    void display() const {
+#ifdef _WIN32
+        system("cls");
+#else
+        system("clear");
+#endif
+
+        displayHeader();
+
+        cout << "┌──────────────────────────────────────────────────────────────┐\n";
+        cout << "│ Process: " << left << setw(52) << name.substr(0, 52) << "│\n";
+        cout << "├──────────────────────────────────────────────────────────────┤\n";
+        cout << "│ Memory Allocated: " << setw(6) << memorySize << " bytes"
+            << setw(24) << " " << "│\n";
+        cout << "├──────────────────────────────────────────────────────────────┤\n";
+        cout << "│ Current Instruction Line: " << setw(6) << currentLine
+            << " of " << setw(6) << totalLines
+            << " (" << setw(3) << (totalLines > 0 ? (currentLine * 100 / totalLines) : 0) << "%)      │\n";
+        cout << "├──────────────────────────────────────────────────────────────┤\n";
+        cout << "│ Timestamp: " << left << setw(53) << timestamp << "│\n";
+        cout << "└──────────────────────────────────────────────────────────────┘\n";
+
+        cout << "\nProgress:\n[";
+        int progressWidth = 50;
+        int pos = (totalLines > 0) ? (progressWidth * currentLine / totalLines) : 0;
+        for (int i = 0; i < progressWidth; ++i) {
+            if (i < pos) cout << "=";
+            else if (i == pos) cout << ">";
+            else cout << " ";
+        }
+        cout << "] " << (totalLines > 0 ? (currentLine * 100 / totalLines) : 0) << "%\n";
+
+        cout << "\nType \"exit\" to return to main menu" << endl;
+    }
+
+    void advance() {
+        if (currentLine < totalLines)
+            currentLine++;
+    }
+
+    // Getter for memory size
+    int getMemorySize() const {
+        return memorySize;
+    }
+
+    // Memory violation related methods
+    bool hasMemoryViolation() const {
+        return memoryViolation;
+    }
+
+    string getViolationTime() const {
+        return violationTime;
+    }
+
+    string getViolationAddress() const {
+        return violationAddress;
+    }
+
+    // Method to trigger a memory access violation
+    void triggerMemoryViolation(const string& hexAddress) {
+        memoryViolation = true;
+        violationAddress = hexAddress;
+
+        // Get current time in HH:MM:SS format
+        time_t now = time(0);
+        tm localtm;
+#ifdef _WIN32
+        localtime_s(&localtm, &now);
+#else
+        localtime_r(&now, &localtm);
+#endif
+        stringstream ss;
+        ss << put_time(&localtm, "%H:%M:%S");
+        violationTime = ss.str();
+    }
+
+    // Method to simulate a random memory violation (for testing purposes)
+    void simulateMemoryViolation() {
+        // Generate a random hex address outside the allocated memory range,
+        // reproducible for a given seed and screen name
+        FastRandom rng = FastRandom::forStream(systemConfig.seed, hash<string>()(name));
+        int invalidAddress = memorySize + rng.below(1000) + 1;
+
+        stringstream ss;
+        ss << "0x" << hex << uppercase << invalidAddress;
+        triggerMemoryViolation(ss.str());
+    }
+};
+// =================== Classes - END =================== //
+
+
+// ===================== Functions ===================== //
+
+// --- System (system.cpp) ---
+void initializeSystem(istream* configSource = nullptr);
+
+// --- Memory manager (memory.cpp) ---
+void pageAddressRange(int vpn, int& begin, int& end);
+int pageOfAddress(int addr);
+uint16_t readMemoryWord(const Process& process, int addr);
+void writeMemoryWord(Process& process, int addr, uint16_t value);
+void resetFrame(FrameInfo& frame);
+int evictFrame();
+void markPageDirty(Process& process, int vpn);
+void breakCopyOnWrite(Process& process, int vpn);
+int allocateFrameForPage(Process& process, int virtualPageNumber, bool loadContents = true);
+bool faultInPage(Process& process, int vpn, bool prefetch = true);
+void finishPageIn(Process& process);
+void recordPageAccess(Process& process, int vpn);
+bool checkFrameTableInvariants(ostream& problems);
+
+// --- Backing store (backing_store.cpp) ---
+void copyPageIn(Process& process, int vpn, const vector<uint16_t>& words);
+void savePagesToBackingStore(Process& process, vector<int> vpns);
+void savePageToBackingStore(Process& process, int vpn);
+void loadFromCompressedPool(Process& process, vector<int>& vpns);
+int loadPagesFromBackingStore(Process& process, vector<int> vpns);
+
+// --- Interpreter (interpreter.cpp) ---
+const ProcessInstruction* fetchNextInstruction(Process& process);
+bool isProgramComplete(const Process& process);
+vector<Process> generateProcessBatch(int count, int firstPid);
+bool executeInstruction(Process* process, const ProcessInstruction& instr, int coreId, ofstream& logFile);
+shared_ptr<const ProgramImage> compileProgram(const string& source, ostream& errors);
+bool parseInstructionsString(const string& raw_instructions, pmr::vector<ProcessInstruction>& instructions, ostream& errors = cout);
+
+// --- Scheduler (scheduler.cpp) ---
+void registerProcessStatuses(const vector<shared_ptr<ProcessStatus>>& statuses);
+vector<ProcessStatusView> snapshotProcessStatuses();
+vector<ProcessStatusView> snapshotAllProcesses(size_t retiredLimit);
+string formatStatusTime(time_t value);
+bool parseProcessMemory(const string& text, int& memorySize);
+Process createUserProcess(const string& name, int memorySize, int pid, shared_ptr<const ProgramImage> program);
+int submitJobFile(const string& path);
+void startScheduler(bool generateWorkload = true);
+void stopScheduler();
+void shutdownSystem();
+
+// --- Reports (reports.cpp) ---
+void displayProcessSMI();
+void generateDetailedMemorySnapshot(int quantumCycle);
+MetricsSnapshot captureMetricsSnapshot();
+void writeLatencySummaryJson(ostream& out, const LatencySummary& summary);
+void writeMetricsJson(ostream& out, const MetricsSnapshot& snap);
+void startMetricsExporter();
+void stopMetricsExporter();
+void printEnhancedVMStat();
+void writeLatencyReport(ostream& out);
+void displaySchedulerUI();
+void generateUtilizationReport(bool allRetired = false);
+
+// =================== Functions - END =================== //
@@ -0,0 +1,140 @@
+/** === AJEL OS: backing store ===
+ * Page transfers between process memory images, the compressed swap pool and the swap file.
+ */
+
+#include "ajel.h"
+
+// ===================== Backing store ===================== //
+
+/**
+ * Copies the words backed by page vpn (see pageAddressRange) into words.
+ * The range is at most the symbol table plus one contiguous run of one page buffer.
+ */
+void copyPageOut(const Process& process, int vpn, vector<uint16_t>& words) {
+    int begin, end;
+    pageAddressRange(vpn, begin, end);
+    words.assign((end - begin) / 2, 0);
+
+    lock_guard<mutex> lock(*process.memoryMutex); // Usually runs on a core evicting another process's page
+
+    int addr = begin;
+    uint16_t* out = words.data();
+    if (addr < SYMBOL_TABLE_BYTES) {
+        int count = (min(end, SYMBOL_TABLE_BYTES) - addr) / 2;
+        memcpy(out, process.symbolTable + addr / 2, count * sizeof(uint16_t));
+        out += count;
+        addr += count * 2;
+    }
+    if (addr < end) {
+        const uint16_t* page = process.memory.findPage(vpn);
+        if (page) memcpy(out, page + (addr / 2) % process.memory.pageWords, (end - addr) / 2 * sizeof(uint16_t));
+    }
+}
+
+/**
+ * Inverse of copyPageOut; allocates the page buffer if needed.
+ */
+void copyPageIn(Process& process, int vpn, const vector<uint16_t>& words) {
+    int begin, end;
+    pageAddressRange(vpn, begin, end);
+    int available = static_cast<int>(words.size());
+    if (available < (end - begin) / 2) end = begin + available * 2;
+
+    lock_guard<mutex> lock(*process.memoryMutex);
+    int addr = begin;
+    const uint16_t* in = words.data();
+    if (addr < SYMBOL_TABLE_BYTES && addr < end) {
+        int count = (min(end, SYMBOL_TABLE_BYTES) - addr) / 2;
+        memcpy(process.symbolTable + addr / 2, in, count * sizeof(uint16_t));
+        in += count;
+        addr += count * 2;
+    }
+    if (addr < end) {
+        uint16_t* page = process.memory.touchPage(vpn);
+        memcpy(page + (addr / 2) % process.memory.pageWords, in, (end - addr) / 2 * sizeof(uint16_t));
+    }
+}
+
+/**
+ * Writes pages of one process to the backing store and marks them as having
+ * a swap copy. Pages go to the compressed pool when it takes them; the rest
+ * are written to the swap file, one call per run of adjacent pages.
+ */
+void savePagesToBackingStore(Process& process, vector<int> vpns) {
+    if (vpns.empty()) return;
+    sort(vpns.begin(), vpns.end());
+
+    vector<int> toDisk;
+    vector<vector<uint16_t>> pages;
+    for (int vpn : vpns) {
+        vector<uint16_t> words;
+        copyPageOut(process, vpn, words);
+        if (compressedPool.store(process, vpn, words)) {
+            process.pageTable[vpn].hasSwapCopy = true;
+            continue;
+        }
+        words.resize(swapDevice.slotWords(), 0);
+        toDisk.push_back(vpn);
+        pages.push_back(move(words));
+    }
+    if (toDisk.empty()) return;
+
+    compressedPool.waitForSpill(process); // An older spilled copy must not land after this write
+    int calls = -1;
+    if (swapDevice.isOpen()) {
+        int base = swapDevice.reserve(process, process.memorySize / systemConfig.mem_per_frame);
+        calls = swapDevice.writePages(base, toDisk, pages);
+    }
+    if (calls < 0) {
+        // An older swap copy would now be stale. Without one the page is reloaded
+        // from the memory image, which was not changed by the eviction.
+        for (int vpn : toDisk) process.pageTable[vpn].hasSwapCopy = false;
+        return;
+    }
+    swapWriteCalls += calls;
+    for (int vpn : toDisk) {
+        process.pageTable[vpn].hasSwapCopy = true;
+    }
+    pageReplacements += static_cast<int>(toDisk.size());
+}
+
+void savePageToBackingStore(Process& process, int vpn) {
+    savePagesToBackingStore(process, { vpn });
+}
+
+/**
+ * Loads the pages held by the compressed pool and removes them from vpns.
+ */
+void loadFromCompressedPool(Process& process, vector<int>& vpns) {
+    if (!compressedPool.isEnabled()) return;
+    vector<uint16_t> words;
+    auto served = remove_if(vpns.begin(), vpns.end(), [&](int vpn) {
+        if (!compressedPool.load(process, vpn, words)) return false;
+        copyPageIn(process, vpn, words);
+        compressedPoolHits++;
+        return true;
+        });
+    vpns.erase(served, vpns.end());
+}
+
+/**
+ * Reads pages of one process back from the backing store: first from the
+ * compressed pool, then from the swap file with one call per run of
+ * adjacent pages. Returns the number of pages read from the swap file.
+ */
+int loadPagesFromBackingStore(Process& process, vector<int> vpns) {
+    loadFromCompressedPool(process, vpns);
+    if (vpns.empty() || process.swapBase < 0) return 0;
+    sort(vpns.begin(), vpns.end());
+
+    vector<vector<uint16_t>> pages(vpns.size(), vector<uint16_t>(swapDevice.slotWords()));
+    int calls = swapDevice.readPages(process.swapBase, vpns, pages);
+    if (calls < 0) return 0;
+    swapReadCalls += calls;
+    for (size_t i = 0; i < vpns.size(); ++i) {
+        copyPageIn(process, vpns[i], pages[i]);
+    }
+    return static_cast<int>(vpns.size());
+}
+
+// =================== Backing store - END =================== //
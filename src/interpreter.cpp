@@ -0,0 +1,874 @@
+/** === AJEL OS: interpreter ===
+ * Program generation, the screen -c parser, the program cache and executeInstruction.
+ */
+
+#include "ajel.h"
+
+// ===================== Interpreter ===================== //
+
+bool checkMemoryViolation(int address, int processMemorySize, const string& operation, int pid, int coreId, ofstream& logFile) {
+    if (address < 0 || address >= processMemorySize) {
+        time_t now = time(0);
+        tm localtm;
+#ifdef _WIN32
+        localtime_s(&localtm, &now);
+#else
+        localtime_r(&now, &localtm);
+#endif
+        stringstream timestamp;
+        timestamp << put_time(&localtm, "(%m/%d/%Y %I:%M:%S %p)");
+
+        stringstream violationAddr;
+        violationAddr << "0x" << hex << uppercase << address;
+
+        logFile << timestamp.str() << " Core:" << coreId
+            << " MEMORY VIOLATION: " << operation << " at address "
+            << violationAddr.str() << " (Process memory: 0x0 - 0x"
+            << hex << uppercase << (processMemorySize - 1) << dec << ")" << endl;
+
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Resolves variable names to symbol table slots. Declaring instructions
+ * (DECLARE, ADD/SUBTRACT destination, READ destination) claim the next free
+ * slot for a new name; other references only look names up. slots carries
+ * the assignments across calls so a program can be resolved chunk by chunk.
+ */
+template <class InstructionList>
+void resolveSymbolSlots(InstructionList& instructions, pmr::unordered_map<pmr::string, int>& slots) {
+    auto declare = [&slots](const pmr::string& name) {
+        auto it = slots.find(name);
+        if (it != slots.end()) return it->second;
+        if (static_cast<int>(slots.size()) >= SYMBOL_TABLE_SLOTS) return -1; // Symbol table full
+        int slot = static_cast<int>(slots.size());
+        slots.emplace(name, slot);
+        return slot;
+    };
+    auto lookup = [&slots](const pmr::string& name) {
+        auto it = slots.find(name);
+        return it != slots.end() ? it->second : -1;
+    };
+
+    // Declarations first, so references inside FOR bodies see later declarations
+    for (auto& instr : instructions) {
+        switch (instr.type) {
+        case ProcessInstruction::DECLARE:
+        case ProcessInstruction::ADD:
+        case ProcessInstruction::SUBTRACT:
+        case ProcessInstruction::READ:
+            instr.var_slot = declare(instr.var_name);
+            break;
+        case ProcessInstruction::FOR_LOOP:
+            resolveSymbolSlots(instr.loop_body, slots);
+            break;
+        default:
+            break;
+        }
+    }
+    for (auto& instr : instructions) {
+        if (instr.type == ProcessInstruction::PRINT || instr.type == ProcessInstruction::WRITE) {
+            instr.var_slot = lookup(instr.var_name);
+        }
+        if (instr.is_three_operand) {
+            instr.arg1_slot = lookup(instr.arg1_var);
+            instr.arg2_slot = lookup(instr.arg2_var);
+        }
+    }
+}
+
+// Names used by generated programs; assigned straight into the instruction's own strings
+const char* const GENERATED_VARIABLES[] = { "var1", "var2", "var3", "var4", "var5", "var6", "var7", "var8", "var9", "var10" };
+const char* const GENERATED_WRITE_VARIABLES[] = { "write_var0", "write_var1", "write_var2", "write_var3", "write_var4" };
+
+/**
+ * Appends about chunkSize generated instructions (a WRITE and the DECLARE
+ * that precedes it count as two), drawing down remaining. The program only
+ * depends on the generator stream, not on how it is split into chunks.
+ */
+template <class InstructionList>
+void appendGeneratedInstructions(InstructionList& instructions, int chunkSize, int& remaining,
+    int processMemorySize, WorkloadGenerator& rng) {
+    int produced = 0;
+
+    // Generate random instructions (FOR_LOOP is never generated)
+    while (remaining > 0 && produced < chunkSize) {
+        ProcessInstruction instr(instructions.get_allocator()); // Strings go to the list's resource
+        instr.type = rng.nextType();
+
+        switch (instr.type) {
+        case ProcessInstruction::PRINT:
+            instr.message = "Hello world from process!";
+            break;
+
+        case ProcessInstruction::DECLARE:
+            instr.var_name = GENERATED_VARIABLES[rng.below(10)];
+            instr.value = rng.below(100);
+            break;
+
+        case ProcessInstruction::ADD:
+            instr.var_name = GENERATED_VARIABLES[rng.below(10)];
+            instr.value = rng.below(50) + 1;
+            break;
+
+        case ProcessInstruction::SUBTRACT:
+            instr.var_name = GENERATED_VARIABLES[rng.below(10)];
+            instr.value = rng.below(50) + 1;
+            break;
+
+        case ProcessInstruction::READ:
+            instr.var_name = GENERATED_VARIABLES[rng.below(10)];
+            instr.memory_address = rng.nextAddress(processMemorySize);
+            break;
+
+        case ProcessInstruction::WRITE:
+            instr.var_name = GENERATED_WRITE_VARIABLES[rng.below(5)];
+            instr.memory_address = rng.nextAddress(processMemorySize);
+            // Add declaration for write variable (if the program has room for it)
+            if (remaining >= 2) {
+                ProcessInstruction decl_instr(instructions.get_allocator());
+                decl_instr.type = ProcessInstruction::DECLARE;
+                decl_instr.var_name = instr.var_name;
+                decl_instr.value = rng.below(500);
+                instructions.push_back(move(decl_instr));
+                remaining--;
+                produced++;
+            }
+            break;
+        }
+        instructions.push_back(move(instr));
+        remaining--;
+        produced++;
+    }
+}
+
+/**
+ * Returns the instruction at process.currentInstructionIndex, generating the
+ * next chunk of a streamed program when the current one is used up.
+ * Returns nullptr once the program is complete. Called by the owning worker.
+ */
+const ProcessInstruction* fetchNextInstruction(Process& process) {
+    if (process.program) {
+        size_t index = static_cast<size_t>(process.currentInstructionIndex);
+        return index < process.program->instructions.size() ? &process.program->instructions[index] : nullptr;
+    }
+
+    size_t local = static_cast<size_t>(process.currentInstructionIndex - process.chunkBase);
+    if (local < process.instructions.size()) return &process.instructions[local];
+    if (!process.generator || process.instructionsToGenerate <= 0) return nullptr;
+
+    process.chunkBase += static_cast<int>(process.instructions.size());
+    process.instructions.clear(); // Keeps the capacity and returns the strings to chunkPool, so memory stays O(chunk)
+    appendGeneratedInstructions(process.instructions, systemConfig.instruction_chunk_size,
+        process.instructionsToGenerate, process.memorySize, *process.generator);
+    resolveSymbolSlots(process.instructions, process.symbolSlots);
+    return process.instructions.empty() ? nullptr : &process.instructions[0];
+}
+
+/**
+ * True once every instruction of the program has been executed.
+ */
+bool isProgramComplete(const Process& process) {
+    if (process.program) return process.currentInstructionIndex >= static_cast<int>(process.program->instructions.size());
+    size_t local = static_cast<size_t>(process.currentInstructionIndex - process.chunkBase);
+    return local >= process.instructions.size() && (!process.generator || process.instructionsToGenerate <= 0);
+}
+
+/**
+ * Builds one scheduler-start process. All randomness comes from the workload
+ * generator's own stream, so the result depends only on the seed and the
+ * process index, not on which generator thread built it.
+ */
+Process createGeneratedProcess(const string& name, int pid, const FastRandom& stream) {
+    auto rng = make_shared<WorkloadGenerator>(systemConfig.workload, stream);
+
+    // Calculate a random, power-of-2 memory size
+    int min_exp = static_cast<int>(log2(systemConfig.min_mem_per_proc));
+    int max_exp = static_cast<int>(log2(systemConfig.max_mem_per_proc));
+    int rand_exp = min_exp + rng->below(max_exp - min_exp + 1);
+    int random_mem_size = static_cast<int>(pow(2, rand_exp));
+
+    Process newProc(name, random_mem_size, pid);
+    int programLength = systemConfig.min_ins + rng->below(systemConfig.max_ins - systemConfig.min_ins + 1);
+    newProc.totalTasks = programLength; // Generated programs have no FOR loops
+    newProc.currentInstructionIndex = 0;
+
+    if (systemConfig.instruction_chunk_size > 0) {
+        // Streamed: chunks are generated by the CPU worker as the process runs
+        newProc.generator = rng;
+        newProc.instructionsToGenerate = programLength;
+        // A chunk can end on a WRITE plus its DECLARE; growing later would strand arena blocks
+        newProc.instructions.reserve(systemConfig.instruction_chunk_size + 1);
+    }
+    else {
+        // The whole program follows from the stream, so it is the cache key. Streams differ per
+        // process index, so this only hits for the same process of an earlier run with the same seed.
+        string key = "gen:" + stream.stateKey();
+        newProc.program = programCache.find(key);
+        if (!newProc.program) {
+            ProgramImage image;
+            image.instructions.reserve(programLength);
+            appendGeneratedInstructions(image.instructions, programLength, programLength, random_mem_size, *rng);
+            pmr::unordered_map<pmr::string, int> slots;
+            resolveSymbolSlots(image.instructions, slots);
+            image.totalTasks = newProc.totalTasks;
+            newProc.program = programCache.insert(key, move(image));
+        }
+    }
+
+    // Initialize the Page Table for the new process
+    int numPages = random_mem_size / systemConfig.mem_per_frame;
+    newProc.pageTable.reserve(numPages);
+    for (int vpn = 0; vpn < numPages; ++vpn) {
+        PageTableEntry& entry = newProc.pageTable[vpn];
+        entry.virtualPageNumber = vpn;
+        entry.valid = false; // Page not yet in memory
+        entry.frameNumber = -1;
+        entry.dirty = false;
+        entry.referenced = false;
+    }
+
+    newProc.publishStatus();
+    return newProc;
+}
+
+/**
+ * Generates count processes across all hardware threads. Process i is named
+ * process<i>, gets PID firstPid + i - 1 and its own PRNG stream, so a given
+ * seed always yields the same workload regardless of the thread count.
+ */
+vector<Process> generateProcessBatch(int count, int firstPid) {
+    int threadCount = static_cast<int>(thread::hardware_concurrency());
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > count / 64 + 1) threadCount = count / 64 + 1; // Not worth a thread for tiny batches
+
+    vector<vector<Process>> chunks(threadCount);
+    vector<thread> generators;
+    int perThread = (count + threadCount - 1) / threadCount;
+
+    for (int t = 0; t < threadCount; ++t) {
+        int begin = t * perThread + 1;
+        int end = begin + perThread - 1;
+        if (end > count) end = count;
+
+        generators.emplace_back([&chunks, t, begin, end, firstPid] {
+            vector<Process>& chunk = chunks[t];
+            if (end >= begin) chunk.reserve(end - begin + 1);
+            for (int i = begin; i <= end; ++i) {
+                stringstream name;
+                name << "process" << setfill('0') << setw(2) << i;
+                FastRandom stream = FastRandom::forStream(systemConfig.seed, static_cast<uint64_t>(i));
+                chunk.push_back(createGeneratedProcess(name.str(), firstPid + i - 1, stream));
+            }
+            });
+    }
+    for (auto& generator : generators) {
+        generator.join();
+    }
+
+    vector<Process> batch;
+    batch.reserve(count);
+    for (auto& chunk : chunks) {
+        for (auto& proc : chunk) batch.push_back(move(proc));
+    }
+    return batch;
+}
+
+/**
+ * True if slot is a valid symbol table slot that has been declared.
+ */
+bool isSlotDeclared(const Process& process, int slot) {
+    return slot >= 0 && (process.declaredSlots & (1u << slot)) != 0;
+}
+
+/**
+ * Faults in page 0, which holds the symbol table, like any other page. Returns
+ * false if the process had to be terminated; with process->pendingPageIn set
+ * the caller must return and let the instruction rerun once the page is in.
+ */
+bool ensureSymbolTablePageLoaded(Process* process, ofstream& logFile, int coreId) {
+    int vpn = 0; // The symbol table is always located in Virtual Page Number 0.
+
+    // Check if the page is not valid (not in a frame)
+    if (process->pageTable.count(vpn) == 0 || !process->pageTable[vpn].valid) {
+        time_t now = time(0);
+        tm localtm;
+#ifdef _WIN32
+        localtime_s(&localtm, &now);
+#else
+        localtime_r(&now, &localtm);
+#endif
+        stringstream timestamp;
+        timestamp << put_time(&localtm, "(%m/%d/%Y %I:%M:%S %p)");
+
+        logFile << timestamp.str() << " Core:" << coreId
+            << " SYMBOL TABLE PAGE FAULT. Attempting to load page " << vpn << "." << endl;
+
+        // Symbol table accesses follow no stride, so they stay out of the prefetcher
+        if (!faultInPage(*process, vpn, false)) {
+            logFile << timestamp.str() << " Core:" << coreId
+                << " FATAL: Page fault failed. No frame available. Process terminated." << endl;
+            process->isFinished = true;
+            process->has_violation = true; // Mark for termination
+            return false; // Fatal error
+        }
+        if (process->pendingPageIn) {
+            logFile << timestamp.str() << " Core:" << coreId << " Page " << vpn << " blocked on I/O." << endl;
+            return true;
+        }
+        logFile << timestamp.str() << " Core:" << coreId << " Page " << vpn << " loaded successfully." << endl;
+    }
+    return true; // Page is now loaded and valid
+}
+
+/**
+ * Execute a single process instruction
+ */
+bool executeInstruction(Process* process, const ProcessInstruction& instr, int coreId, ofstream& logFile) {
+    // Generate timestamp
+    time_t now = time(0);
+    tm localtm;
+#ifdef _WIN32
+    localtime_s(&localtm, &now);
+#else
+    localtime_r(&now, &localtm);
+#endif
+    stringstream timestamp;
+    timestamp << put_time(&localtm, "(%m/%d/%Y %I:%M:%S %p)");
+
+    switch (instr.type) {
+    case ProcessInstruction::PRINT: {
+        string output(instr.message);
+        if (instr.print_has_variable) {
+            // This is the new format: message + variable
+            if (isSlotDeclared(*process, instr.var_slot)) {
+                output += to_string(process->symbolTable[instr.var_slot]);
+            }
+            else {
+                output += "[undeclared]";
+            }
+        }
+        // Log the final composed message
+        logFile << timestamp.str() << " Core:" << coreId << " \"" << output << "\"" << endl;
+        this_thread::sleep_for(chrono::milliseconds(systemConfig.delay_per_exec));
+        process->tasksCompleted++;
+        break;
+    }
+
+    case ProcessInstruction::DECLARE: {
+        // A variable declaration is a WRITE to the symbol table. Ensure page is loaded.
+        if (!ensureSymbolTablePageLoaded(process, logFile, coreId)) return false;
+        if (process->pendingPageIn) return true; // Reruns once the page is in
+
+        // Symbol table is 64 bytes. Each var is 2 bytes (uint16_t). Max 32 vars.
+        if (instr.var_slot < 0) {
+            logFile << timestamp.str() << " Core:" << coreId << " DECLARE " << instr.var_name << " ignored. Symbol table full." << endl;
+        }
+        else {
+            writeMemoryWord(*process, instr.var_slot * 2, static_cast<uint16_t>(instr.value)); // Write value to virtual memory
+            process->declaredSlots |= 1u << instr.var_slot;
+
+            // Mark the page as dirty since we wrote to it
+            markPageDirty(*process, 0);
+
+            logFile << timestamp.str() << " Core:" << coreId << " DECLARE " << instr.var_name
+                << " = " << instr.value << " at offset " << instr.var_slot * 2 << endl;
+            this_thread::sleep_for(chrono::milliseconds(systemConfig.delay_per_exec));
+            process->tasksCompleted++;
+        }
+        break;
+    }
+
+    case ProcessInstruction::ADD:
+    case ProcessInstruction::SUBTRACT: {
+        // Accessing a variable requires reading and writing to the symbol table.
+        if (!ensureSymbolTablePageLoaded(process, logFile, coreId)) return false;
+        if (process->pendingPageIn) return true; // Reruns once the page is in
+
+        if (instr.var_slot < 0) {
+            logFile << timestamp.str() << " Core:" << coreId << " "
+                << (instr.type == ProcessInstruction::ADD ? "ADD" : "SUBTRACT")
+                << " on " << instr.var_name << " ignored. Symbol table full." << endl;
+            break; // Don't complete the instruction
+        }
+
+        // Auto-declare (initialized with 0) if variable doesn't exist
+        if (!isSlotDeclared(*process, instr.var_slot)) {
+            writeMemoryWord(*process, instr.var_slot * 2, 0);
+            process->declaredSlots |= 1u << instr.var_slot;
+        }
+
+        uint16_t currentValue = process->symbolTable[instr.var_slot];
+
+        if (instr.is_three_operand) {
+            // ADD/SUBTRACT dest src1 src2, where a source is a variable or a literal
+            auto operand = [process](const pmr::string& var, int slot, int literal) -> uint16_t {
+                if (var.empty()) return static_cast<uint16_t>(literal);
+                return isSlotDeclared(*process, slot) ? process->symbolTable[slot] : 0;
+            };
+            uint16_t val1 = operand(instr.arg1_var, instr.arg1_slot, instr.arg1_value);
+            uint16_t val2 = operand(instr.arg2_var, instr.arg2_slot, instr.arg2_value);
+            bool add = instr.type == ProcessInstruction::ADD;
+            currentValue = add ? val1 + val2 : val1 - val2;
+            logFile << timestamp.str() << " Core:" << coreId << (add ? " ADD " : " SUBTRACT ")
+                << (instr.arg1_var.empty() ? to_string(instr.arg1_value) : string(instr.arg1_var)) << (add ? " + " : " - ")
+                << (instr.arg2_var.empty() ? to_string(instr.arg2_value) : string(instr.arg2_var)) << " into " << instr.var_name;
+        }
+        else if (instr.type == ProcessInstruction::ADD) {
+            // Original format: ADD var value
+            currentValue += instr.value;
+            logFile << timestamp.str() << " Core:" << coreId << " ADD " << instr.value
+                << " to " << instr.var_name;
+        }
+        else {
+            currentValue -= instr.value;
+            logFile << timestamp.str() << " Core:" << coreId << " SUBTRACT " << instr.value
+                << " from " << instr.var_name;
+        }
+
+        writeMemoryWord(*process, instr.var_slot * 2, currentValue); // Write back the result
+
+        // Mark the page as dirty
+        markPageDirty(*process, 0);
+
+        logFile << " (result: " << currentValue << ")" << endl;
+
+        this_thread::sleep_for(chrono::milliseconds(systemConfig.delay_per_exec));
+        process->tasksCompleted++;
+        break;
+    }
+
+  
+
+    case ProcessInstruction::READ: {
+        int addr = instr.memory_address;
+
+        // Fix: Memory size is in KB, convert to bytes properly
+        int memoryInBytes = process->memorySize; // memorySize is already in bytes based on screen creation
+
+        // Check for memory violation before proceeding
+        if (addr < 0 || addr >= memoryInBytes) {
+            process->isFinished = true;
+            process->has_violation = true;
+            stringstream ss;
+            ss << "0x" << hex << uppercase << addr;
+            process->violation_address = ss.str();
+            logFile << timestamp.str() << " Core:" << coreId << " MEMORY VIOLATION on READ at " << process->violation_address
+                << ". Valid range: 0x0 - 0x" << hex << uppercase << (memoryInBytes - 1) << dec << ". Process terminated." << endl;
+            return false;
+        }
+
+        // 1. Handle page fault for the source memory address
+        int vpn_source = pageOfAddress(addr);
+        if (process->pageTable.count(vpn_source) == 0 || !process->pageTable[vpn_source].valid) {
+            if (!faultInPage(*process, vpn_source)) {
+                logFile << timestamp.str() << " Core:" << coreId << " PAGE FAULT FAILED on READ. Process terminated." << endl;
+                process->isFinished = true;
+                process->has_violation = true;
+                return false;
+            }
+            if (process->pendingPageIn) {
+                logFile << timestamp.str() << " Core:" << coreId << " PAGE FAULT on READ at page " << vpn_source
+                    << ". Blocked on I/O." << endl;
+                return true; // Reruns once the page is in
+            }
+        }
+        recordPageAccess(*process, vpn_source);
+
+        // Read value from the source address
+        uint16_t value_read = readMemoryWord(*process, addr);
+
+        // 2. Handle page fault for the destination (the symbol table)
+        if (!ensureSymbolTablePageLoaded(process, logFile, coreId)) return false;
+        if (process->pendingPageIn) return true; // Reruns once the page is in
+
+        if (instr.var_slot < 0) {
+            logFile << timestamp.str() << " Core:" << coreId << " READ into " << instr.var_name << " ignored. Symbol table full." << endl;
+            break;
+        }
+
+        // Write the value to the symbol table in memory (auto-declares the variable)
+        writeMemoryWord(*process, instr.var_slot * 2, value_read);
+        process->declaredSlots |= 1u << instr.var_slot;
+
+        // Mark the symbol table page as dirty
+        markPageDirty(*process, 0);
+
+        logFile << timestamp.str() << " Core:" << coreId << " READ " << value_read << " from 0x" << hex << setw(4) << setfill('0') << addr << dec << " into " << instr.var_name << endl;
+
+        this_thread::sleep_for(chrono::milliseconds(systemConfig.delay_per_exec));
+        process->tasksCompleted++;
+        break;
+    }
+
+    case ProcessInstruction::WRITE: {
+        int addr = instr.memory_address;
+
+        // Fix: Memory size is in KB, convert to bytes properly  
+        int memoryInBytes = process->memorySize; // memorySize is already in bytes based on screen creation
+
+        // Bounds check for destination address
+        if (addr < 0 || addr >= memoryInBytes) {
+            process->isFinished = true;
+            process->has_violation = true;
+            stringstream ss;
+            ss << "0x" << hex << uppercase << addr;
+            process->violation_address = ss.str();
+            logFile << timestamp.str() << " Core:" << coreId << " MEMORY VIOLATION on WRITE at " << process->violation_address
+                << ". Valid range: 0x0 - 0x" << hex << uppercase << (memoryInBytes - 1) << dec << ". Process terminated." << endl;
+            return false;
+        }
+
+        // 1. Get value from variable, which requires accessing the symbol table
+        if (!ensureSymbolTablePageLoaded(process, logFile, coreId)) return false;
+        if (process->pendingPageIn) return true; // Reruns once the page is in
+
+        uint16_t valueToWrite = 0;
+        if (isSlotDeclared(*process, instr.var_slot)) {
+            valueToWrite = process->symbolTable[instr.var_slot];
+        }
+
+        // 2. Page fault check for the destination address
+        int vpn_dest = pageOfAddress(addr);
+        if (process->pageTable.count(vpn_dest) == 0 || !process->pageTable[vpn_dest].valid) {
+            if (!faultInPage(*process, vpn_dest)) {
+                logFile << timestamp.str() << " Core:" << coreId << " PAGE FAULT FAILED on WRITE. Process terminated." << endl;
+                process->isFinished = true;
+                process->has_violation = true;
+                return false;
+            }
+            if (process->pendingPageIn) {
+                logFile << timestamp.str() << " Core:" << coreId << " PAGE FAULT on WRITE at page " << vpn_dest
+                    << ". Blocked on I/O." << endl;
+                return true; // Reruns once the page is in
+            }
+        }
+
+        // Write the value to the destination address in memory
+        breakCopyOnWrite(*process, vpn_dest);
+        writeMemoryWord(*process, addr, valueToWrite);
+
+        // Mark destination page as dirty and referenced
+        recordPageAccess(*process, vpn_dest);
+        markPageDirty(*process, vpn_dest);
+
+        logFile << timestamp.str() << " Core:" << coreId << " WRITE " << dec << valueToWrite << " (from " << instr.var_name << ") to 0x" << hex << setw(4) << setfill('0') << addr << dec << endl;
+
+        this_thread::sleep_for(chrono::milliseconds(systemConfig.delay_per_exec));
+        process->tasksCompleted++;
+        break;
+    }
+    }
+    return true;
+}
+
+/**
+ * Count total instructions (including loop iterations)
+ */
+int countTotalInstructions(const pmr::vector<ProcessInstruction>& instructions) {
+    int total = 0;
+    for (const auto& instr : instructions) {
+        if (instr.type == ProcessInstruction::FOR_LOOP) {
+            total += 1; // For the loop declaration
+            total += instr.loop_count * countTotalInstructions(instr.loop_body);
+        }
+        else {
+            total += 1;
+        }
+    }
+    return total;
+}
+
+/**
+ * Returns the shared program for a screen -c instruction string. It is only
+ * parsed if no live process already runs the same program. Parse errors are
+ * written to errors and give nullptr. Safe to call from several threads.
+ */
+shared_ptr<const ProgramImage> compileProgram(const string& source, ostream& errors) {
+    string key = "src:" + source; // Identical instruction strings share one parsed program
+    shared_ptr<const ProgramImage> program = programCache.find(key);
+    if (program) return program;
+
+    ProgramImage image;
+    if (!parseInstructionsString(source, image.instructions, errors)) return nullptr;
+    image.totalTasks = countTotalInstructions(image.instructions);
+    return programCache.insert(key, move(image));
+}
+
+// ===== Instruction parser =====
+
+const int MAX_FOR_NESTING = 3;                   // FOR loops inside FOR loops
+
+const long long MAX_EXPANDED_INSTRUCTIONS = 65536; // A program's length once its FOR loops are unrolled
+
+/**
+ * Single-pass recursive-descent parser for screen -c programs. Tokens are
+ * string_views into the source and numbers are read with from_chars, so
+ * the instructions themselves are the only allocations. On error it writes
+ * one line to errors, giving the 1-based column and what was found there.
+ *
+ *   program  := [stmt] (';' [stmt])*
+ *   stmt     := DECLARE var num
+ *             | ADD var operand [operand] | SUBTRACT var operand [operand]
+ *             | READ var addr | WRITE addr var
+ *             | PRINT '(' ( '"' text '"' ['+' var] | var ) ')'
+ *             | FOR '(' '[' program ']' ',' num ')'
+ *   operand  := var | num
+ *   addr     := decimal or 0x-prefixed hex
+ */
+class InstructionParser {
+private:
+    string_view src;
+    size_t pos = 0;
+    ostream& errors;
+    bool failed = false;
+
+    static bool isIdentStart(char c) { return isalpha(static_cast<unsigned char>(c)) || c == '_'; }
+    static bool isIdentChar(char c) { return isalnum(static_cast<unsigned char>(c)) || c == '_'; }
+
+    void skipSpace() {
+        while (pos < src.size() && isspace(static_cast<unsigned char>(src[pos]))) ++pos;
+    }
+
+    bool atStatementEnd(int depth) {
+        skipSpace();
+        return pos >= src.size() || src[pos] == ';' || (depth > 0 && src[pos] == ']');
+    }
+
+    bool accept(char c) {
+        skipSpace();
+        if (pos < src.size() && src[pos] == c) {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    bool expect(char c) {
+        return accept(c) || fail(string("expected '") + c + "'");
+    }
+
+    bool fail(const string& what) {
+        if (failed) return false;
+        failed = true;
+        skipSpace();
+        size_t end = pos;
+        while (end < src.size() && isIdentChar(src[end])) ++end;
+        if (end == pos && pos < src.size()) ++end; // A single punctuation character
+        errors << "Error at column " << pos + 1 << ": " << what;
+        if (end == pos) errors << ", found end of input" << endl;
+        else errors << ", found '" << src.substr(pos, end - pos) << "'" << endl;
+        return false;
+    }
+
+    bool identifier(pmr::string& out) {
+        skipSpace();
+        if (pos >= src.size() || !isIdentStart(src[pos])) return fail("expected a variable name");
+        size_t start = pos;
+        while (pos < src.size() && isIdentChar(src[pos])) ++pos;
+        out.assign(src.substr(start, pos - start));
+        return true;
+    }
+
+    bool number(int& out, bool address) {
+        skipSpace();
+        const char* first = src.data() + pos;
+        const char* last = src.data() + src.size();
+        int base = 10;
+        if (address && last - first > 2 && first[0] == '0' && (first[1] == 'x' || first[1] == 'X')) {
+            first += 2;
+            base = 16;
+        }
+        auto [end, ec] = from_chars(first, last, out, base);
+        if (ec == errc::result_out_of_range) return fail("number out of range");
+        if (ec != errc() || (end < last && isIdentChar(*end)) || (address && out < 0)) {
+            return fail(address ? "expected an address" : "expected a number");
+        }
+        pos = end - src.data();
+        return true;
+    }
+
+    // A variable (name set) or a literal (name left empty)
+    bool operand(pmr::string& name, int& value) {
+        skipSpace();
+        if (pos < src.size() && isIdentStart(src[pos])) return identifier(name);
+        return number(value, false);
+    }
+
+    bool arithmetic(ProcessInstruction& instr, int depth) {
+        pmr::string first;
+        int firstValue = 0;
+        if (!identifier(instr.var_name) || !operand(first, firstValue)) return false;
+        if (atStatementEnd(depth)) {
+            if (first.empty()) {
+                instr.value = firstValue; // ADD var value
+            }
+            else {
+                instr.is_three_operand = true; // ADD var other => var = var + other
+                instr.arg1_var = instr.var_name;
+                instr.arg2_var = move(first);
+            }
+            return true;
+        }
+        instr.is_three_operand = true;
+        instr.arg1_var = move(first);
+        instr.arg1_value = firstValue;
+        return operand(instr.arg2_var, instr.arg2_value);
+    }
+
+    bool print(ProcessInstruction& instr) {
+        if (!expect('(')) return false;
+        skipSpace();
+        if (pos < src.size() && src[pos] == '"') {
+            size_t close = src.find('"', pos + 1);
+            if (close == string_view::npos) return fail("unterminated string");
+            instr.message.assign(src.substr(pos + 1, close - pos - 1));
+            pos = close + 1;
+            if (accept('+')) {
+                if (!identifier(instr.var_name)) return false;
+                instr.print_has_variable = true;
+            }
+        }
+        else {
+            if (!identifier(instr.var_name)) return false;
+            instr.print_has_variable = true;
+        }
+        return expect(')');
+    }
+
+    bool forLoop(ProcessInstruction& instr, int depth) {
+        if (depth >= MAX_FOR_NESTING) return fail("FOR loops nest at most " + to_string(MAX_FOR_NESTING) + " deep");
+        if (!expect('(') || !expect('[')) return false;
+        if (!sequence(instr.loop_body, depth + 1) || !expect(']') || !expect(',')) return false;
+        if (!number(instr.loop_count, false)) return false;
+        if (instr.loop_count < 0) return fail("expected a non-negative repeat count");
+        return expect(')');
+    }
+
+    bool statement(pmr::vector<ProcessInstruction>& out, int depth) {
+        skipSpace();
+        size_t start = pos;
+        while (pos < src.size() && isIdentChar(src[pos])) ++pos;
+        string_view keyword = src.substr(start, pos - start);
+
+        ProcessInstruction instr;
+        bool ok;
+        if (keyword == "DECLARE") {
+            instr.type = ProcessInstruction::DECLARE;
+            ok = identifier(instr.var_name) && number(instr.value, false);
+        }
+        else if (keyword == "ADD" || keyword == "SUBTRACT") {
+            instr.type = keyword == "ADD" ? ProcessInstruction::ADD : ProcessInstruction::SUBTRACT;
+            ok = arithmetic(instr, depth);
+        }
+        else if (keyword == "READ") {
+            instr.type = ProcessInstruction::READ;
+            ok = identifier(instr.var_name) && number(instr.memory_address, true);
+        }
+        else if (keyword == "WRITE") {
+            instr.type = ProcessInstruction::WRITE;
+            ok = number(instr.memory_address, true) && identifier(instr.var_name);
+        }
+        else if (keyword == "PRINT") {
+            instr.type = ProcessInstruction::PRINT;
+            ok = print(instr);
+        }
+        else if (keyword == "FOR") {
+            instr.type = ProcessInstruction::FOR_LOOP;
+            ok = forLoop(instr, depth);
+        }
+        else {
+            pos = start;
+            return fail("expected an instruction");
+        }
+        if (!ok) return false;
+
+        statements++;
+        out.push_back(move(instr));
+        return true;
+    }
+
+    // Statements separated by ';' up to the end of input, or the ']' closing a FOR body
+    bool sequence(pmr::vector<ProcessInstruction>& out, int depth) {
+        while (true) {
+            if (accept(';')) continue; // Empty statement
+            if (atStatementEnd(depth)) return true;
+            if (!statement(out, depth)) return false;
+            if (!atStatementEnd(depth)) return fail("expected ';'");
+        }
+    }
+
+public:
+    int statements = 0; // Instructions in the source, FOR loops and their bodies included
+
+    InstructionParser(string_view source, ostream& errorStream) : src(source), errors(errorStream) {}
+
+    bool parse(pmr::vector<ProcessInstruction>& out) {
+        return sequence(out, 0);
+    }
+};
+
+/**
+ * Instructions program executes once its FOR loops are unrolled, stopping
+ * early once the count passes limit.
+ */
+long long expandedLength(const pmr::vector<ProcessInstruction>& program, long long limit) {
+    long long total = 0;
+    for (const auto& instr : program) {
+        if (instr.type == ProcessInstruction::FOR_LOOP) {
+            long long body = expandedLength(instr.loop_body, limit);
+            total += instr.loop_count > 0 && body > limit / instr.loop_count ? limit + 1 : body * instr.loop_count;
+        }
+        else {
+            total++;
+        }
+        if (total > limit) return limit + 1;
+    }
+    return total;
+}
+
+/**
+ * Appends program to out with every FOR loop unrolled, so a process runs
+ * it as a flat sequence with a single program counter.
+ */
+void appendExpanded(const pmr::vector<ProcessInstruction>& program, pmr::vector<ProcessInstruction>& out) {
+    for (const auto& instr : program) {
+        if (instr.type == ProcessInstruction::FOR_LOOP) {
+            for (int i = 0; i < instr.loop_count; ++i) appendExpanded(instr.loop_body, out);
+        }
+        else {
+            out.push_back(instr);
+        }
+    }
+}
+
+/**
+ * Parses a screen -c program into instructions, with FOR loops unrolled and
+ * symbol slots resolved. Errors are written to errors.
+ */
+bool parseInstructionsString(const string& raw_instructions, pmr::vector<ProcessInstruction>& instructions, ostream& errors) {
+    pmr::vector<ProcessInstruction> program;
+    InstructionParser parser(raw_instructions, errors);
+    if (!parser.parse(program)) return false;
+
+    if (parser.statements < 1 || parser.statements > systemConfig.max_user_instructions) {
+        errors << "Error: Instruction count must be between 1 and " << systemConfig.max_user_instructions
+            << ". Found: " << parser.statements << endl;
+        return false;
+    }
+    long long length = expandedLength(program, MAX_EXPANDED_INSTRUCTIONS);
+    if (length > MAX_EXPANDED_INSTRUCTIONS) {
+        errors << "Error: FOR loops expand to more than " << MAX_EXPANDED_INSTRUCTIONS << " instructions." << endl;
+        return false;
+    }
+
+    instructions.reserve(instructions.size() + static_cast<size_t>(length));
+    appendExpanded(program, instructions);
+    pmr::unordered_map<pmr::string, int> slots;
+    resolveSymbolSlots(instructions, slots);
+    return true;
+}
+
+// =================== Interpreter - END =================== //
@@ -0,0 +1,467 @@
+/** === AJEL OS: memory manager ===
+ * Frame table, page faults, eviction, prefetching and copy-on-write.
+ */
+
+#include "ajel.h"
+
+// ===================== Memory manager ===================== //
+
+/**
+ * Byte range [begin, end) of a process's address space backed by a page.
+ * The symbol table always belongs to page 0, even when frames are smaller than it.
+ */
+void pageAddressRange(int vpn, int& begin, int& end) {
+    begin = vpn * systemConfig.mem_per_frame;
+    end = begin + systemConfig.mem_per_frame;
+    if (vpn == 0) {
+        if (end < SYMBOL_TABLE_BYTES) end = SYMBOL_TABLE_BYTES;
+    }
+    else if (begin < SYMBOL_TABLE_BYTES) {
+        begin = SYMBOL_TABLE_BYTES;
+        if (end < begin) end = begin;
+    }
+}
+
+/**
+ * Virtual page that holds an address (see pageAddressRange).
+ */
+int pageOfAddress(int addr) {
+    return addr < SYMBOL_TABLE_BYTES ? 0 : addr / systemConfig.mem_per_frame;
+}
+
+/**
+ * Reads the 16-bit word at addr; the symbol table segment is process.symbolTable.
+ */
+uint16_t readMemoryWord(const Process& process, int addr) {
+    if (addr >= 0 && addr < SYMBOL_TABLE_BYTES) return process.symbolTable[addr / 2];
+    return process.memory.read(addr);
+}
+
+/**
+ * Writes the 16-bit word at addr. Only the thread that owns the process may call this.
+ * Symbol table writes break copy-on-write on page 0 here; other writes must call
+ * breakCopyOnWrite first.
+ */
+void writeMemoryWord(Process& process, int addr, uint16_t value) {
+    if (addr >= 0 && addr < SYMBOL_TABLE_BYTES) breakCopyOnWrite(process, 0); // Takes frameTableMutex, so before memoryMutex
+    lock_guard<mutex> lock(*process.memoryMutex); // An evicting core may be copying the page out
+    if (addr >= 0 && addr < SYMBOL_TABLE_BYTES) process.symbolTable[addr / 2] = value;
+    else process.memory.write(addr, value);
+}
+
+/**
+ * Marks a frame dirty, keeping dirtyFrameCount in sync. Call with frameTableMutex held.
+ */
+void markFrameDirty(int frameNum) {
+    if (frameNum < 0 || frameNum >= static_cast<int>(frameTable.size())) return;
+    if (!frameTable[frameNum].dirty) dirtyFrameCount++;
+    frameTable[frameNum].dirty = true;
+}
+
+/**
+ * Returns a frame to the free pool, keeping the frame counters in sync.
+ */
+void resetFrame(FrameInfo& frame) {
+    if (!frame.isFree) usedFrameCount--;
+    if (frame.dirty) dirtyFrameCount--;
+    frame.isFree = true;
+    frame.ownerPID = -1;
+    frame.owner = nullptr;
+    frame.virtualPageNumber = -1;
+    frame.dirty = false;
+    frame.referenced = false;
+    frame.sharers.clear();
+}
+
+/**
+ * Maps a page into frameIndex. With loadContents false the caller reads the
+ * page in itself (see faultInPage, which batches several pages).
+ */
+int assignFrameToPage(Process& process, int virtualPageNumber, int frameIndex, bool loadContents) {
+    FrameInfo& frame = frameTable[frameIndex];
+
+    if (frame.isFree) usedFrameCount++;
+    if (frame.dirty) dirtyFrameCount--;
+    frame.isFree = false;
+    frame.ownerPID = process.pid;
+    frame.owner = &process;
+    frame.virtualPageNumber = virtualPageNumber;
+    frame.dirty = false;
+    frame.referenced = true;
+
+    // Update page table entry
+    PageTableEntry& entry = process.pageTable[virtualPageNumber];
+    entry.virtualPageNumber = virtualPageNumber;
+    entry.frameNumber = frameIndex;
+    entry.valid = true;
+    entry.dirty = false;
+    entry.referenced = true;
+    entry.prefetched = false;
+    process.status->residentPages++;
+
+    // Add frame to eviction queue
+    frameEvictionQueue.push(frameIndex);
+
+    if (!loadContents) return frameIndex;
+
+    // Only pages that were written out are read back. A page without a swap copy
+    // has never been written, so its (zero) contents are already in the memory image.
+    if (entry.hasSwapCopy) {
+        pagesPagedIn += loadPagesFromBackingStore(process, { virtualPageNumber });
+    }
+    else if (entry.cow) {
+        cowFaults++; // The shared copy is already in the memory image
+    }
+    else {
+        zeroFillFaults++;
+    }
+
+    return frameIndex;
+}
+
+/**
+ * Evicts a frame using FIFO policy and returns the freed frame number.
+ * Also updates the corresponding process's page table. Call with
+ * frameTableMutex held.
+ */
+int evictFrameLocked() {
+    while (!frameEvictionQueue.empty()) {
+        int evictedFrame = frameEvictionQueue.front();
+        frameEvictionQueue.pop();
+
+        if (evictedFrame < 0 || evictedFrame >= static_cast<int>(frameTable.size())) {
+            continue;
+        }
+
+        FrameInfo& evicted = frameTable[evictedFrame];
+        int evictedVPN = evicted.virtualPageNumber;
+
+        if (evicted.owner) {
+            Process& evictedProcess = *evicted.owner;
+
+            // Save page to backing store if dirty, together with the process's other
+            // dirty resident pages so their own evictions need no write
+            if (evicted.dirty) {
+                vector<int> writeback{ evictedVPN };
+                for (auto& [vpn, entry] : evictedProcess.pageTable) {
+                    if (vpn == evictedVPN || !entry.valid || entry.frameNumber < 0) continue;
+                    FrameInfo& frame = frameTable[entry.frameNumber];
+                    if (frame.dirty && frame.owner == &evictedProcess && frame.virtualPageNumber == vpn) {
+                        writeback.push_back(vpn);
+                    }
+                }
+                savePagesToBackingStore(evictedProcess, writeback);
+                for (size_t i = 1; i < writeback.size(); ++i) {
+                    PageTableEntry& entry = evictedProcess.pageTable[writeback[i]];
+                    if (!entry.hasSwapCopy) continue; // Write failed; stays dirty
+                    frameTable[entry.frameNumber].dirty = false;
+                    dirtyFrameCount--;
+                    entry.dirty = false;
+                }
+            }
+
+            // Invalidate the page in the page table
+            if (evictedProcess.pageTable.count(evictedVPN) && evictedProcess.pageTable[evictedVPN].valid) {
+                evictedProcess.pageTable[evictedVPN].valid = false;
+                evictedProcess.status->residentPages--;
+            }
+            // Copy-on-write sharers fault it back in from the shared copy, so no write-back
+            for (Process* sharer : evicted.sharers) {
+                auto entry = sharer->pageTable.find(evictedVPN);
+                if (entry == sharer->pageTable.end() || !entry->second.valid) continue;
+                entry->second.valid = false;
+                sharer->status->residentPages--;
+            }
+        }
+
+        // Reset the frame
+        resetFrame(evicted);
+
+        return evictedFrame;
+    }
+
+    return -1; // No frame to evict
+}
+
+int evictFrame() {
+    lock_guard<mutex> lock(frameTableMutex);
+    return evictFrameLocked();
+}
+
+/**
+ * Records a write to one of the process's pages. If another core evicted the
+ * page between the write and this call, the frame no longer belongs to it, so
+ * the page is written back directly instead of the new value being lost.
+ * The caller must have called breakCopyOnWrite before writing; a page still
+ * shared here is counted in sharedPageWrites.
+ */
+void markPageDirty(Process& process, int vpn) {
+    lock_guard<mutex> lock(frameTableMutex);
+    PageTableEntry& entry = process.pageTable[vpn];
+    entry.dirty = true;
+    if (entry.cow) sharedPageWrites++;
+
+    int frameNum = entry.frameNumber;
+    bool stillResident = entry.valid && frameNum >= 0 && frameNum < static_cast<int>(frameTable.size()) &&
+        frameTable[frameNum].ownerPID == process.pid && frameTable[frameNum].virtualPageNumber == vpn;
+    if (stillResident) markFrameDirty(frameNum);
+    else savePageToBackingStore(process, vpn);
+}
+
+/**
+ * Write-fault path for a copy-on-write page: gives the process its own copy
+ * of the contents and sole use of the frame. Other processes that shared the
+ * frame lose their mapping and fault the page back in from their shared copy.
+ * Call before writing to the page.
+ */
+void breakCopyOnWrite(Process& process, int vpn) {
+    if (!process.pageTable[vpn].cow) return; // Only the owning thread sets or clears cow
+    lock_guard<mutex> lock(frameTableMutex);
+    PageTableEntry& entry = process.pageTable[vpn];
+    entry.cow = false;
+    if (process.memory.isShared(vpn)) {
+        lock_guard<mutex> memory_lock(*process.memoryMutex);
+        process.memory.touchPage(vpn);
+        cowPageCopies++;
+    }
+
+    int frameNum = entry.frameNumber;
+    if (!entry.valid || frameNum < 0 || frameNum >= static_cast<int>(frameTable.size())) return;
+    FrameInfo& frame = frameTable[frameNum];
+    if (frame.sharers.empty()) return;
+
+    if (frame.owner != &process) frame.sharers.push_back(frame.owner);
+    for (Process* other : frame.sharers) {
+        if (other == &process) continue;
+        auto otherEntry = other->pageTable.find(vpn);
+        if (otherEntry == other->pageTable.end() || !otherEntry->second.valid) continue;
+        otherEntry->second.valid = false;
+        other->status->residentPages--;
+    }
+    frame.sharers.clear();
+    frame.owner = &process;
+    frame.ownerPID = process.pid;
+}
+
+/**
+ * Allocates a frame for the given virtual page of a process.
+ * Returns the frame number if successful, or -1 if no free frame is available.
+ */
+int allocateFrameForPage(Process& process, int virtualPageNumber, bool loadContents) {
+    // Held across the scan and the assignment so two cores cannot claim the same frame
+    lock_guard<mutex> lock(frameTableMutex);
+
+    // First, search for a free frame
+    for (size_t i = 0; i < frameTable.size(); ++i) {
+        if (frameTable[i].isFree) {
+            // Use the free frame
+            return assignFrameToPage(process, virtualPageNumber, static_cast<int>(i), loadContents);
+        }
+    }
+
+    // Evict if no free frame found 
+    int evictedFrame = evictFrameLocked();
+    if (evictedFrame != -1) {
+        return assignFrameToPage(process, virtualPageNumber, evictedFrame, loadContents);
+    }
+
+    return -1;
+}
+
+/**
+ * Updates the process's fault pattern and returns the pages worth bringing in
+ * along with a fault on vpn: the next prefetch-pages pages once two faults in a
+ * row had the same stride, and swapped neighbors within fault-around-pages when
+ * vpn itself is swapped in. Only non-resident pages inside the process are returned.
+ */
+vector<int> choosePrefetchPages(Process& process, int vpn) {
+    int stride = process.lastFaultPage >= 0 ? vpn - process.lastFaultPage : 0;
+    if (stride != 0 && stride == process.faultStride) process.strideRun++;
+    else process.strideRun = 0;
+    process.faultStride = stride;
+    process.lastFaultPage = vpn;
+
+    vector<int> pages;
+    int numPages = process.memorySize / systemConfig.mem_per_frame;
+    auto consider = [&](int candidate, bool swappedOnly) {
+        if (candidate < 0 || candidate >= numPages || candidate == vpn) return;
+        auto it = process.pageTable.find(candidate);
+        if (it == process.pageTable.end() || it->second.valid) return;
+        if (swappedOnly && !it->second.hasSwapCopy) return;
+        if (find(pages.begin(), pages.end(), candidate) == pages.end()) pages.push_back(candidate);
+    };
+
+    if (systemConfig.prefetch_pages > 0 && process.strideRun >= 1) {
+        for (int k = 1; k <= systemConfig.prefetch_pages; ++k) consider(vpn + k * stride, false);
+    }
+    if (systemConfig.fault_around_pages > 0 && process.pageTable[vpn].hasSwapCopy) {
+        for (int k = 1; k <= systemConfig.fault_around_pages; ++k) {
+            consider(vpn - k, true);
+            consider(vpn + k, true);
+        }
+    }
+    return pages;
+}
+
+/**
+ * Services a page fault on vpn. Prefetched pages (only with prefetch set) take
+ * free frames only (they never evict), and every page that needs backing-store
+ * data is read in one batched pass after frameTableMutex is released. With
+ * asynchronous page-fault I/O that pass is left in process.pendingPageIn for
+ * the caller to park the process on, unless the instruction already parked once.
+ * Returns false if no frame could be found for vpn.
+ */
+bool faultInPage(Process& process, int vpn, bool prefetch) {
+    pageFaults++;
+    if (allocateFrameForPage(process, vpn, false) == -1) return false;
+
+    vector<int> toLoad;
+    if (process.pageTable[vpn].hasSwapCopy) toLoad.push_back(vpn);
+    else if (process.pageTable[vpn].cow) cowFaults++;
+    else zeroFillFaults++;
+
+    vector<int> candidates = prefetch ? choosePrefetchPages(process, vpn) : vector<int>();
+    if (!candidates.empty()) {
+        lock_guard<mutex> lock(frameTableMutex);
+        size_t frameIndex = 0;
+        for (int page : candidates) {
+            while (frameIndex < frameTable.size() && !frameTable[frameIndex].isFree) frameIndex++;
+            if (frameIndex == frameTable.size()) break;
+
+            assignFrameToPage(process, page, static_cast<int>(frameIndex), false);
+            process.pageTable[page].prefetched = true;
+            pagesPrefetched++;
+            if (process.pageTable[page].hasSwapCopy) toLoad.push_back(page);
+        }
+    }
+
+    loadFromCompressedPool(process, toLoad); // No I/O, so never worth blocking on
+    if (pageFaultService.isAsync() && !process.resumedFromPageIn && !toLoad.empty() && process.swapBase >= 0) {
+        sort(toLoad.begin(), toLoad.end());
+        auto pending = make_unique<PendingPageIn>();
+        pending->faultPage = vpn;
+        pending->pages.assign(toLoad.size(), vector<uint16_t>(swapDevice.slotWords()));
+        pending->vpns = move(toLoad);
+        process.pendingPageIn = move(pending);
+        return true;
+    }
+
+    pagesPagedIn += loadPagesFromBackingStore(process, toLoad);
+    return true;
+}
+
+/**
+ * Completes a swap-in started by faultInPage. Called by the core that
+ * resumes the process, so only the owner ever writes its memory image.
+ * If other cores evicted the faulting page while the process was blocked, it
+ * is mapped again from the data just read; refaulting instead could starve
+ * the process under memory pressure.
+ */
+void finishPageIn(Process& process) {
+    unique_ptr<PendingPageIn> pending = move(process.pendingPageIn);
+    process.resumedFromPageIn = true;
+    pageInWaitHist.recordSince(pending->submittedAt);
+    if (!pending->failed) {
+        for (size_t i = 0; i < pending->vpns.size(); ++i) {
+            copyPageIn(process, pending->vpns[i], pending->pages[i]);
+        }
+        pagesPagedIn += static_cast<int>(pending->vpns.size());
+    }
+    bool stillMapped;
+    {
+        lock_guard<mutex> lock(frameTableMutex); // Other cores clear valid when they evict
+        stillMapped = process.pageTable[pending->faultPage].valid;
+    }
+    if (!stillMapped) allocateFrameForPage(process, pending->faultPage, false);
+}
+
+/**
+ * Marks a resident page referenced and counts the first access to a prefetched page.
+ */
+void recordPageAccess(Process& process, int vpn) {
+    PageTableEntry& entry = process.pageTable[vpn];
+    entry.referenced = true;
+    if (entry.prefetched) {
+        entry.prefetched = false;
+        prefetchHits++;
+    }
+}
+
+/**
+ * Allocates a frame or evicts an old one to make space.
+ */
+int ensureFrameAvailable(Process& process, int virtualPageNumber) {
+    int frame = allocateFrameForPage(process, virtualPageNumber);
+
+    if (frame != -1) {
+        return frame; // Success
+    }
+
+    // Need to evict
+    int evictedFrame = evictFrame();
+    if (evictedFrame == -1) return -1;
+
+    // Retry allocation after eviction
+    return allocateFrameForPage(process, virtualPageNumber);
+}
+
+/**
+ * Checks the frame table against the page tables that map it: no page of a
+ * process is held by two frames, a frame's owner and sharers all map it, and
+ * usedFrameCount/dirtyFrameCount match the table. Reports each problem to
+ * problems and returns true if there were none. Safe while the scheduler runs.
+ */
+bool checkFrameTableInvariants(ostream& problems) {
+    lock_guard<mutex> lock(frameTableMutex);
+    bool ok = true;
+    auto report = [&](int frameNum, const string& what) {
+        problems << "Frame " << frameNum << ": " << what << endl;
+        ok = false;
+    };
+
+    int used = 0;
+    int dirty = 0;
+    map<pair<int, int>, int> mappedAt; // (pid, vpn) -> frame
+    for (int frameNum = 0; frameNum < static_cast<int>(frameTable.size()); ++frameNum) {
+        const FrameInfo& frame = frameTable[frameNum];
+        if (frame.isFree) {
+            if (frame.owner || !frame.sharers.empty()) report(frameNum, "free but still mapped");
+            continue;
+        }
+        used++;
+        if (frame.dirty) dirty++;
+        if (!frame.owner) {
+            report(frameNum, "in use without an owner");
+            continue;
+        }
+        if (frame.ownerPID != frame.owner->pid) {
+            report(frameNum, "ownerPID " + to_string(frame.ownerPID) + " but owned by PID " + to_string(frame.owner->pid));
+        }
+
+        int vpn = frame.virtualPageNumber;
+        vector<Process*> mappers{ frame.owner };
+        mappers.insert(mappers.end(), frame.sharers.begin(), frame.sharers.end());
+        for (Process* process : mappers) {
+            string page = "page " + to_string(vpn) + " of PID " + to_string(process->pid);
+            auto [previous, inserted] = mappedAt.emplace(make_pair(process->pid, vpn), frameNum);
+            if (!inserted) report(frameNum, page + " is also in frame " + to_string(previous->second));
+
+            auto entry = process->pageTable.find(vpn);
+            if (entry == process->pageTable.end() || !entry->second.valid || entry->second.frameNumber != frameNum) {
+                report(frameNum, page + " is not mapped to this frame by its page table");
+            }
+        }
+    }
+
+    if (used != usedFrameCount.load()) {
+        problems << "usedFrameCount is " << usedFrameCount.load() << " but " << used << " frames are in use" << endl;
+        ok = false;
+    }
+    if (dirty != dirtyFrameCount.load()) {
+        problems << "dirtyFrameCount is " << dirtyFrameCount.load() << " but " << dirty << " frames are dirty" << endl;
+        ok = false;
+    }
+    return ok;
+}
+
+// =================== Memory manager - END =================== //
@@ -0,0 +1,1019 @@
+/** === AJEL OS: reports ===
+ * Console reports (screen -ls, process-smi, vmstat, report-util), memory snapshots and the metrics exporter.
+ */
+
+#include "ajel.h"
+
+// ===================== Reports ===================== //
+
+void printVMStat() {
+    lock_guard<mutex> procLock(processMutex);
+    lock_guard<mutex> waitLock(waiting_queue_mutex);
+    lock_guard<mutex> queueLock(queue_mutex);
+    lock_guard<mutex> memLock(memory_mutex);
+
+    int totalMemBytes = systemConfig.max_overall_mem * 1024; // Converts Kb to b
+    int usedMemBytes = current_memory_used * 1024;
+    int freeMemBytes = totalMemBytes - usedMemBytes;
+
+    cout << "\n=== VM STATISTICS ===" << endl;
+
+    cout << "\n[Memory Usage]" << endl;
+    cout << "Total Memory (bytes)  : " << totalMemBytes << endl;
+    cout << "Used Memory (bytes)   : " << usedMemBytes << endl;
+    cout << "Free Memory (bytes)   : " << freeMemBytes << endl;
+
+    cout << "\n[CPU]" << endl;
+    cout << "Total CPU Ticks       : " << totalCpuTicks.load() << endl;
+    cout << "Active CPU Ticks      : " << activeCpuTicks.load() << endl;
+    cout << "Idle CPU Ticks        : " << idleCpuTicks.load() << endl;
+
+    cout << "\n[Paging]" << endl;
+    cout << "Pages Paged In        : " << pagesPagedIn.load() << endl;
+    cout << "Zero-Fill Faults      : " << zeroFillFaults.load() << endl;
+    cout << "Pages Paged Out       : " << pageReplacements.load() << endl;
+}
+
+void generateMemorySnapshot(int quantumCycle) {
+    time_t now = time(0);
+    tm localtm;
+#ifdef _WIN32
+    localtime_s(&localtm, &now);
+#else
+    localtime_r(&now, &localtm);
+#endif
+    stringstream timestamp;
+    timestamp << put_time(&localtm, "(%m/%d/%Y %I:%M:%S%p)");
+
+    vector<tuple<int, string, int>> memoryLayout;
+    int nextAddress = 0;
+
+    // isFinished belongs to the worker running the process, so read the published status
+    for (const auto& proc : snapshotProcessStatuses()) {
+        if (proc.state == ProcessStatusView::RUNNING || proc.state == ProcessStatusView::BLOCKED) {
+            int start = nextAddress;
+            int end = start + proc.memorySize; // Use process-specific memory size
+            memoryLayout.emplace_back(end, proc.name, start);
+            nextAddress = end;
+        }
+    }
+
+    int totalExternalFragmentation = systemConfig.max_overall_mem - nextAddress;
+
+    stringstream filename;
+    filename << "memory_stamp_" << setfill('0') << setw(2) << quantumCycle << ".txt";
+    ofstream outfile(filename.str());
+    if (!outfile.is_open()) return;
+
+    outfile << "Timestamp: " << timestamp.str() << endl;
+    outfile << "Number of processes in memory: " << memoryLayout.size() << endl;
+    outfile << "Total external fragmentation in KB: " << totalExternalFragmentation << endl;
+    outfile << "----end---- = " << systemConfig.max_overall_mem << endl;
+
+    sort(memoryLayout.begin(), memoryLayout.end(), [](const tuple<int, string, int>& a, const tuple<int, string, int>& b) {
+        return get<0>(a) > get<0>(b); // Sort by end address in descending order
+        });
+
+    for (const auto& [end, name, start] : memoryLayout) {
+        outfile << end << endl;
+        outfile << name << endl;
+        outfile << start << endl;
+    }
+
+    outfile << "----start-- = 0" << endl;
+    outfile.close();
+}
+
+/**
+ * Returns the last maxLines lines of a file by seeking backwards from the end
+ * in fixed-size blocks, so the cost does not depend on the file size.
+ * Returns false if the file cannot be opened.
+ */
+bool readLastLines(const string& fileName, int maxLines, vector<string>& lines) {
+    lines.clear();
+    ifstream infile(fileName, ios::binary);
+    if (!infile.is_open()) return false;
+
+    infile.seekg(0, ios::end);
+    streamoff pos = infile.tellg();
+    const streamoff BLOCK_SIZE = 4096;
+
+    // Collect chunks from the end until we have seen maxLines line breaks
+    // (plus one for the trailing newline of the last line)
+    string tail;
+    int newlines = 0;
+    while (pos > 0 && newlines <= maxLines) {
+        streamoff readSize = pos < BLOCK_SIZE ? pos : BLOCK_SIZE;
+        pos -= readSize;
+
+        string block(static_cast<size_t>(readSize), '\0');
+        infile.seekg(pos);
+        infile.read(&block[0], readSize);
+        newlines += static_cast<int>(count(block.begin(), block.end(), '\n'));
+        tail.insert(0, block);
+    }
+
+    stringstream ss(tail);
+    string line;
+    while (getline(ss, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        lines.push_back(line);
+    }
+
+    // The first line may be partial when we stopped mid-file
+    if (static_cast<int>(lines.size()) > maxLines) {
+        lines.erase(lines.begin(), lines.end() - maxLines);
+    }
+    return true;
+}
+
+void displayProcessSMI() {
+    // Lock-free snapshot of the live processes; the workers keep running while we read log files
+    vector<ProcessStatusView> processInfos = snapshotProcessStatuses();
+    processInfos.erase(remove_if(processInfos.begin(), processInfos.end(), [](const ProcessStatusView& info) {
+        return info.state == ProcessStatusView::FINISHED || info.state == ProcessStatusView::VIOLATION;
+        }), processInfos.end());
+    int totalMemUsed = current_memory_used.load();
+
+    cout << "\n=== PROCESS-SMI REPORT ===" << endl;
+    cout << "Total Memory Used: " << totalMemUsed << " / " << systemConfig.max_overall_mem << " KB" << endl;
+    cout << "Total Frames: " << (systemConfig.max_overall_mem / systemConfig.mem_per_frame) << endl;
+    cout << "Frame Size: " << systemConfig.mem_per_frame << " KB" << endl;
+    cout << "Retired Processes: " << processesFinished.load() << " (" << processesViolated.load()
+        << " memory violations, see screen -ls)" << endl;
+    cout << string(80, '=') << endl;
+
+    int idx = 1;
+    for (const auto& info : processInfos) {
+        const string& name = info.name;
+        int core = info.core;
+        int completed = info.tasksCompleted;
+        int total = info.totalTasks;
+        bool isFinished = info.state == ProcessStatusView::FINISHED || info.state == ProcessStatusView::VIOLATION;
+        bool has_violation = info.state == ProcessStatusView::VIOLATION;
+        const string& violation_addr = info.violationAddress;
+        int memSize = info.memorySize;
+        int validPages = info.residentPages;
+
+        cout << "\n== Process " << idx++ << " ==" << endl;
+        cout << "Name: " << name << endl;
+        cout << "PID: " << (idx - 1) << endl;
+        cout << "Core: " << (core == -1 ? "N/A" : to_string(core)) << endl;
+        cout << "Memory Allocated: " << memSize << " KB" << endl;
+        cout << "Pages in Memory: " << validPages << " / " << (memSize / systemConfig.mem_per_frame) << endl;
+        cout << "Progress: " << completed << " / " << total << " instructions" << endl;
+
+        string status;
+        if (isFinished) {
+            status = has_violation ? "Terminated (Memory Violation)" : "Finished";
+            if (has_violation) {
+                cout << "Violation Address: " << violation_addr << endl;
+            }
+        }
+        else if (info.state == ProcessStatusView::BLOCKED) {
+            status = "Blocked on I/O";
+        }
+        else {
+            status = (core == -1) ? "Waiting for CPU" : "Running";
+        }
+        cout << "Status: " << status << endl;
+
+        // Show recent log entries
+        cout << "-- Recent Log Entries --" << endl;
+        string logFileName = name + ".txt";
+        vector<string> lines;
+        if (readLastLines(logFileName, 3, lines)) {
+            for (const auto& line : lines) {
+                cout << "  " << line << endl;
+            }
+        }
+        else {
+            cout << "  (No log file found)" << endl;
+        }
+        cout << string(50, '-') << endl;
+    }
+}
+
+void generateDetailedMemorySnapshot(int quantumCycle) {
+    time_t now = time(0);
+    tm localtm;
+#ifdef _WIN32
+    localtime_s(&localtm, &now);
+#else
+    localtime_r(&now, &localtm);
+#endif
+    stringstream timestamp;
+    timestamp << put_time(&localtm, "(%m/%d/%Y %I:%M:%S%p)");
+
+    // Collect memory layout information
+    vector<tuple<int, string, int, int, int>> memoryLayout; // end, name, start, pid, pages_in_memory
+    int nextAddress = 0;
+    int totalProcesses = 0;
+    int totalPagesInMemory = 0;
+
+    // Runs on the CPU workers, so read the lock-free status and frame counters
+    for (const auto& proc : snapshotProcessStatuses()) {
+        if (proc.state == ProcessStatusView::RUNNING || proc.state == ProcessStatusView::BLOCKED) {
+            int start = nextAddress;
+            int end = start + proc.memorySize;
+            totalPagesInMemory += proc.residentPages;
+
+            memoryLayout.emplace_back(end, proc.name, start, proc.pid, proc.residentPages);
+            nextAddress = end;
+            totalProcesses++;
+        }
+    }
+
+    int totalExternalFragmentation = systemConfig.max_overall_mem - nextAddress;
+    int totalFrames = systemConfig.max_overall_mem / systemConfig.mem_per_frame;
+    int freeFrames = totalFrames - usedFrameCount.load();
+
+    stringstream filename;
+    filename << "memory_stamp_" << setfill('0') << setw(2) << quantumCycle << ".txt";
+    ofstream outfile(filename.str());
+    if (!outfile.is_open()) return;
+
+    outfile << "Memory Snapshot " << timestamp.str() << endl;
+    outfile << "Quantum Cycle: " << quantumCycle << endl;
+    outfile << "Number of processes in memory: " << totalProcesses << endl;
+    outfile << "Total pages in memory: " << totalPagesInMemory << " / " << totalFrames << endl;
+    outfile << "Free frames: " << freeFrames << endl;
+    outfile << "External fragmentation: " << totalExternalFragmentation << " KB" << endl;
+    outfile << string(60, '=') << endl;
+
+    // Sort by end address (descending for the format requirement)
+    sort(memoryLayout.begin(), memoryLayout.end(), [](const tuple<int, string, int, int, int>& a, const tuple<int, string, int, int, int>& b) {
+        return get<0>(a) > get<0>(b);
+        });
+
+    outfile << "----end---- = " << systemConfig.max_overall_mem << endl;
+    for (const auto& [end, name, start, pid, pagesInMem] : memoryLayout) {
+        outfile << end << endl;
+        outfile << name << " (PID:" << pid << ", Pages:" << pagesInMem << ")" << endl;
+        outfile << start << endl;
+    }
+    outfile << "----start-- = 0" << endl;
+
+    outfile.close();
+}
+
+/**
+ * Reduces a histogram to the percentiles reported by the metrics exports.
+ */
+LatencySummary summarizeHistogram(const LatencyHistogram& hist) {
+    LatencySummary summary;
+    summary.count = hist.count();
+    summary.sum = hist.sum();
+    summary.min = hist.minimum();
+    summary.mean = hist.mean();
+    summary.p50 = hist.percentile(50);
+    summary.p90 = hist.percentile(90);
+    summary.p99 = hist.percentile(99);
+    summary.p999 = hist.percentile(99.9);
+    summary.max = hist.maximum();
+    return summary;
+}
+
+/**
+ * Captures the current system metrics from the lock-free counters.
+ * No mutex is taken, so the values may be a few instructions apart from each
+ * other, but each one is individually consistent.
+ */
+MetricsSnapshot captureMetricsSnapshot() {
+    MetricsSnapshot snap;
+    snap.timestamp = time(nullptr);
+
+    snap.totalMemBytes = static_cast<long long>(systemConfig.max_overall_mem) * 1024;
+    snap.usedMemBytes = static_cast<long long>(current_memory_used.load()) * 1024;
+
+    snap.totalFrames = static_cast<int>(frameTable.size()); // Fixed after initializeSystem()
+    snap.usedFrames = usedFrameCount.load();
+    snap.dirtyFrames = dirtyFrameCount.load();
+    snap.frameSize = systemConfig.mem_per_frame;
+
+    snap.totalCores = systemConfig.num_cpu;
+    snap.busyCores = busyCoreCount.load();
+    for (const auto& busy : coreBusyMicros) snap.coreBusyMicros.push_back(busy.load());
+    snap.totalCpuTicks = totalCpuTicks.load();
+    snap.activeCpuTicks = activeCpuTicks.load();
+    snap.idleCpuTicks = idleCpuTicks.load();
+
+    snap.pageFaults = pageFaults.load();
+    snap.pagesPagedIn = pagesPagedIn.load();
+    snap.zeroFillFaults = zeroFillFaults.load();
+    snap.pagesPagedOut = pageReplacements.load();
+    snap.pagesPrefetched = pagesPrefetched.load();
+    snap.prefetchHits = prefetchHits.load();
+    snap.swapReadCalls = swapReadCalls.load();
+    snap.swapWriteCalls = swapWriteCalls.load();
+    snap.asyncPageIns = asyncPageIns.load();
+    snap.pagesCompressed = pagesCompressed.load();
+    snap.compressedPoolHits = compressedPoolHits.load();
+    snap.pagesSpilled = pagesSpilled.load();
+    snap.compressedPoolPages = compressedPoolPages.load();
+    snap.compressedPoolBytes = compressedPoolBytes.load();
+    snap.compressedPoolCapacity = static_cast<long long>(compressedPool.capacityBytes());
+    snap.cowFaults = cowFaults.load();
+    snap.cowPageCopies = cowPageCopies.load();
+    snap.forkedProcs = processesForked.load();
+    snap.programImages = programImages.load();
+    snap.programCacheHits = programCacheHits.load();
+    snap.programCacheMisses = programCacheMisses.load();
+    snap.blockedProcs = blockedOnIoCount.load();
+
+    // Read in reverse order of the lifecycle so derived gauges never go negative
+    snap.finishedProcs = processesFinished.load();
+    snap.violatedProcs = processesViolated.load();
+    int started = processesStarted.load();
+    snap.totalProcs = processesCreated.load();
+    snap.runningProcs = started - snap.finishedProcs;
+    snap.waitingProcs = snap.totalProcs - started;
+
+    snap.readyQueueDepth = readyQueueDepth.load();
+    snap.waitingQueueDepth = waitingQueueDepth.load();
+    snap.instructionsExecuted = instructionsExecuted.load();
+
+    snap.readyQueueWait = summarizeHistogram(readyQueueWaitHist);
+    snap.admissionWait = summarizeHistogram(admissionWaitHist);
+    snap.turnaround = summarizeHistogram(turnaroundHist);
+    snap.pageInWait = summarizeHistogram(pageInWaitHist);
+    for (int type = 0; type < INSTRUCTION_TYPE_COUNT; ++type) {
+        snap.instructionExec[type] = summarizeHistogram(instructionExecHist[type]);
+    }
+    return snap;
+}
+
+void writeLatencySummaryJson(ostream& out, const LatencySummary& summary) {
+    out << "{\"count\": " << summary.count
+        << ", \"min\": " << summary.min
+        << ", \"mean\": " << fixed << setprecision(1) << summary.mean << defaultfloat
+        << ", \"p50\": " << summary.p50
+        << ", \"p90\": " << summary.p90
+        << ", \"p99\": " << summary.p99
+        << ", \"p999\": " << summary.p999
+        << ", \"max\": " << summary.max << "}";
+}
+
+/**
+ * Writes a metrics snapshot as a JSON document (vmstat --json, report-util --json).
+ * Latencies are in microseconds.
+ */
+void writeMetricsJson(ostream& out, const MetricsSnapshot& snap) {
+    out << "{" << endl;
+    out << "  \"timestamp\": " << snap.timestamp << "," << endl;
+    out << "  \"memory\": {\"total_bytes\": " << snap.totalMemBytes
+        << ", \"used_bytes\": " << snap.usedMemBytes
+        << ", \"free_bytes\": " << (snap.totalMemBytes - snap.usedMemBytes) << "}," << endl;
+    out << "  \"frames\": {\"total\": " << snap.totalFrames
+        << ", \"used\": " << snap.usedFrames
+        << ", \"free\": " << (snap.totalFrames - snap.usedFrames)
+        << ", \"dirty\": " << snap.dirtyFrames
+        << ", \"size\": " << snap.frameSize << "}," << endl;
+    out << "  \"cpu\": {\"cores\": " << snap.totalCores
+        << ", \"busy_cores\": " << snap.busyCores
+        << ", \"total_ticks\": " << snap.totalCpuTicks
+        << ", \"active_ticks\": " << snap.activeCpuTicks
+        << ", \"idle_ticks\": " << snap.idleCpuTicks
+        << ", \"core_busy_us\": [";
+    for (size_t core = 0; core < snap.coreBusyMicros.size(); ++core) {
+        out << (core ? ", " : "") << snap.coreBusyMicros[core];
+    }
+    out << "]}," << endl;
+    out << "  \"paging\": {\"page_faults\": " << snap.pageFaults
+        << ", \"pages_paged_in\": " << snap.pagesPagedIn
+        << ", \"zero_fill_faults\": " << snap.zeroFillFaults
+        << ", \"cow_faults\": " << snap.cowFaults
+        << ", \"cow_page_copies\": " << snap.cowPageCopies
+        << ", \"pages_paged_out\": " << snap.pagesPagedOut
+        << ", \"pages_prefetched\": " << snap.pagesPrefetched
+        << ", \"prefetch_hits\": " << snap.prefetchHits
+        << ", \"swap_read_calls\": " << snap.swapReadCalls
+        << ", \"swap_write_calls\": " << snap.swapWriteCalls
+        << ", \"async_page_ins\": " << snap.asyncPageIns << "}," << endl;
+    out << "  \"compressed_pool\": {\"capacity_bytes\": " << snap.compressedPoolCapacity
+        << ", \"used_bytes\": " << snap.compressedPoolBytes
+        << ", \"pages\": " << snap.compressedPoolPages
+        << ", \"pages_stored\": " << snap.pagesCompressed
+        << ", \"hits\": " << snap.compressedPoolHits
+        << ", \"pages_spilled\": " << snap.pagesSpilled << "}," << endl;
+    out << "  \"processes\": {\"running\": " << snap.runningProcs
+        << ", \"blocked_on_io\": " << snap.blockedProcs
+        << ", \"waiting\": " << snap.waitingProcs
+        << ", \"finished\": " << snap.finishedProcs
+        << ", \"violations\": " << snap.violatedProcs
+        << ", \"forked\": " << snap.forkedProcs
+        << ", \"total\": " << snap.totalProcs << "}," << endl;
+    out << "  \"program_cache\": {\"images\": " << snap.programImages
+        << ", \"hits\": " << snap.programCacheHits
+        << ", \"misses\": " << snap.programCacheMisses << "}," << endl;
+    out << "  \"queues\": {\"ready\": " << snap.readyQueueDepth
+        << ", \"waiting_for_memory\": " << snap.waitingQueueDepth << "}," << endl;
+    out << "  \"instructions_executed\": " << snap.instructionsExecuted << "," << endl;
+
+    out << "  \"latency_us\": {" << endl;
+    out << "    \"ready_queue_wait\": ";
+    writeLatencySummaryJson(out, snap.readyQueueWait);
+    out << "," << endl << "    \"admission_wait\": ";
+    writeLatencySummaryJson(out, snap.admissionWait);
+    out << "," << endl << "    \"turnaround\": ";
+    writeLatencySummaryJson(out, snap.turnaround);
+    out << "," << endl << "    \"page_in_wait\": ";
+    writeLatencySummaryJson(out, snap.pageInWait);
+    out << "," << endl << "    \"instruction_exec\": {" << endl;
+    bool first = true;
+    for (int type = 0; type < INSTRUCTION_TYPE_COUNT; ++type) {
+        if (type == ProcessInstruction::FOR_LOOP) continue; // Never dispatched on its own
+        if (!first) out << "," << endl;
+        first = false;
+        out << "      \"" << instructionTypeName(type) << "\": ";
+        writeLatencySummaryJson(out, snap.instructionExec[type]);
+    }
+    out << endl << "    }" << endl;
+    out << "  }" << endl;
+    out << "}" << endl;
+}
+
+void writePrometheusSummary(ostream& out, const string& name, const string& labels, const LatencySummary& summary) {
+    string prefix = labels.empty() ? "" : labels + ",";
+    string suffix = labels.empty() ? "" : "{" + labels + "}";
+    auto seconds = [](uint64_t micros) { return static_cast<double>(micros) / 1e6; };
+
+    out << name << "{" << prefix << "quantile=\"0.5\"} " << seconds(summary.p50) << "\n";
+    out << name << "{" << prefix << "quantile=\"0.9\"} " << seconds(summary.p90) << "\n";
+    out << name << "{" << prefix << "quantile=\"0.99\"} " << seconds(summary.p99) << "\n";
+    out << name << "{" << prefix << "quantile=\"0.999\"} " << seconds(summary.p999) << "\n";
+    out << name << "_sum" << suffix << " " << seconds(summary.sum) << "\n";
+    out << name << "_count" << suffix << " " << summary.count << "\n";
+}
+
+/**
+ * Writes a metrics snapshot in the Prometheus text exposition format.
+ */
+void writeMetricsPrometheus(ostream& out, const MetricsSnapshot& snap) {
+    out << setprecision(9);
+
+    out << "# HELP ajel_memory_bytes Configured memory by state.\n";
+    out << "# TYPE ajel_memory_bytes gauge\n";
+    out << "ajel_memory_bytes{state=\"used\"} " << snap.usedMemBytes << "\n";
+    out << "ajel_memory_bytes{state=\"free\"} " << (snap.totalMemBytes - snap.usedMemBytes) << "\n";
+
+    out << "# HELP ajel_frames Physical frames by state.\n";
+    out << "# TYPE ajel_frames gauge\n";
+    out << "ajel_frames{state=\"used\"} " << snap.usedFrames << "\n";
+    out << "ajel_frames{state=\"free\"} " << (snap.totalFrames - snap.usedFrames) << "\n";
+    out << "ajel_frames{state=\"dirty\"} " << snap.dirtyFrames << "\n";
+
+    out << "# HELP ajel_cpu_cores CPU cores by state.\n";
+    out << "# TYPE ajel_cpu_cores gauge\n";
+    out << "ajel_cpu_cores{state=\"busy\"} " << snap.busyCores << "\n";
+    out << "ajel_cpu_cores{state=\"idle\"} " << (snap.totalCores - snap.busyCores) << "\n";
+
+    out << "# HELP ajel_cpu_ticks_total CPU ticks by state.\n";
+    out << "# TYPE ajel_cpu_ticks_total counter\n";
+    out << "ajel_cpu_ticks_total{state=\"active\"} " << snap.activeCpuTicks << "\n";
+    out << "ajel_cpu_ticks_total{state=\"idle\"} " << snap.idleCpuTicks << "\n";
+
+    out << "# HELP ajel_core_busy_seconds_total Time each core spent running processes.\n";
+    out << "# TYPE ajel_core_busy_seconds_total counter\n";
+    for (size_t core = 0; core < snap.coreBusyMicros.size(); ++core) {
+        out << "ajel_core_busy_seconds_total{core=\"" << core << "\"} " << snap.coreBusyMicros[core] / 1e6 << "\n";
+    }
+
+    out << "# HELP ajel_page_faults_total Page faults serviced.\n";
+    out << "# TYPE ajel_page_faults_total counter\n";
+    out << "ajel_page_faults_total " << snap.pageFaults << "\n";
+    out << "# HELP ajel_pages_paged_in_total Page faults served from the backing store.\n";
+    out << "# TYPE ajel_pages_paged_in_total counter\n";
+    out << "ajel_pages_paged_in_total " << snap.pagesPagedIn << "\n";
+    out << "# HELP ajel_zero_fill_faults_total Page faults on never-swapped pages, served without I/O.\n";
+    out << "# TYPE ajel_zero_fill_faults_total counter\n";
+    out << "ajel_zero_fill_faults_total " << snap.zeroFillFaults << "\n";
+    out << "# HELP ajel_cow_faults_total Page faults on copy-on-write pages, served from the shared copy.\n";
+    out << "# TYPE ajel_cow_faults_total counter\n";
+    out << "ajel_cow_faults_total " << snap.cowFaults << "\n";
+    out << "# HELP ajel_cow_page_copies_total Shared pages copied on a write.\n";
+    out << "# TYPE ajel_cow_page_copies_total counter\n";
+    out << "ajel_cow_page_copies_total " << snap.cowPageCopies << "\n";
+    out << "# HELP ajel_pages_paged_out_total Pages written to the backing store.\n";
+    out << "# TYPE ajel_pages_paged_out_total counter\n";
+    out << "ajel_pages_paged_out_total " << snap.pagesPagedOut << "\n";
+    out << "# HELP ajel_pages_prefetched_total Pages brought in by prefetch or fault-around.\n";
+    out << "# TYPE ajel_pages_prefetched_total counter\n";
+    out << "ajel_pages_prefetched_total " << snap.pagesPrefetched << "\n";
+    out << "# HELP ajel_prefetch_hits_total Prefetched pages accessed before eviction.\n";
+    out << "# TYPE ajel_prefetch_hits_total counter\n";
+    out << "ajel_prefetch_hits_total " << snap.prefetchHits << "\n";
+    out << "# HELP ajel_swap_io_calls_total Vectored swap file calls.\n";
+    out << "# TYPE ajel_swap_io_calls_total counter\n";
+    out << "ajel_swap_io_calls_total{op=\"read\"} " << snap.swapReadCalls << "\n";
+    out << "ajel_swap_io_calls_total{op=\"write\"} " << snap.swapWriteCalls << "\n";
+    out << "# HELP ajel_async_page_ins_total Faults whose swap-in ran while the core ran other processes.\n";
+    out << "# TYPE ajel_async_page_ins_total counter\n";
+    out << "ajel_async_page_ins_total " << snap.asyncPageIns << "\n";
+    out << "# HELP ajel_compressed_pool_bytes Compressed swap pool size by state.\n";
+    out << "# TYPE ajel_compressed_pool_bytes gauge\n";
+    out << "ajel_compressed_pool_bytes{state=\"used\"} " << snap.compressedPoolBytes << "\n";
+    out << "ajel_compressed_pool_bytes{state=\"free\"} " << (snap.compressedPoolCapacity - snap.compressedPoolBytes) << "\n";
+    out << "# HELP ajel_compressed_pool_pages Pages held in the compressed swap pool.\n";
+    out << "# TYPE ajel_compressed_pool_pages gauge\n";
+    out << "ajel_compressed_pool_pages " << snap.compressedPoolPages << "\n";
+    out << "# HELP ajel_compressed_pool_pages_total Compressed swap pool traffic by operation.\n";
+    out << "# TYPE ajel_compressed_pool_pages_total counter\n";
+    out << "ajel_compressed_pool_pages_total{op=\"store\"} " << snap.pagesCompressed << "\n";
+    out << "ajel_compressed_pool_pages_total{op=\"hit\"} " << snap.compressedPoolHits << "\n";
+    out << "ajel_compressed_pool_pages_total{op=\"spill\"} " << snap.pagesSpilled << "\n";
+
+    out << "# HELP ajel_processes Processes by state.\n";
+    out << "# TYPE ajel_processes gauge\n";
+    out << "ajel_processes{state=\"running\"} " << (snap.runningProcs - snap.blockedProcs) << "\n";
+    out << "ajel_processes{state=\"blocked_on_io\"} " << snap.blockedProcs << "\n";
+    out << "ajel_processes{state=\"waiting\"} " << snap.waitingProcs << "\n";
+    out << "ajel_processes{state=\"finished\"} " << snap.finishedProcs << "\n";
+    out << "# HELP ajel_process_violations_total Processes terminated by a memory violation.\n";
+    out << "# TYPE ajel_process_violations_total counter\n";
+    out << "ajel_process_violations_total " << snap.violatedProcs << "\n";
+    out << "# HELP ajel_processes_forked_total Processes created by screen -f.\n";
+    out << "# TYPE ajel_processes_forked_total counter\n";
+    out << "ajel_processes_forked_total " << snap.forkedProcs << "\n";
+    out << "# HELP ajel_program_images Shared program images currently in use.\n";
+    out << "# TYPE ajel_program_images gauge\n";
+    out << "ajel_program_images " << snap.programImages << "\n";
+    out << "# HELP ajel_program_cache_lookups_total Program cache lookups when creating a process.\n";
+    out << "# TYPE ajel_program_cache_lookups_total counter\n";
+    out << "ajel_program_cache_lookups_total{result=\"hit\"} " << snap.programCacheHits << "\n";
+    out << "ajel_program_cache_lookups_total{result=\"miss\"} " << snap.programCacheMisses << "\n";
+
+    out << "# HELP ajel_queue_depth Scheduler queue lengths.\n";
+    out << "# TYPE ajel_queue_depth gauge\n";
+    out << "ajel_queue_depth{queue=\"ready\"} " << snap.readyQueueDepth << "\n";
+    out << "ajel_queue_depth{queue=\"waiting_for_memory\"} " << snap.waitingQueueDepth << "\n";
+
+    out << "# HELP ajel_instructions_executed_total Instructions executed by all cores.\n";
+    out << "# TYPE ajel_instructions_executed_total counter\n";
+    out << "ajel_instructions_executed_total " << snap.instructionsExecuted << "\n";
+
+    out << "# HELP ajel_ready_queue_wait_seconds Time between ready_queue push and dispatch.\n";
+    out << "# TYPE ajel_ready_queue_wait_seconds summary\n";
+    writePrometheusSummary(out, "ajel_ready_queue_wait_seconds", "", snap.readyQueueWait);
+    out << "# HELP ajel_admission_wait_seconds Time spent in waiting_for_memory_queue.\n";
+    out << "# TYPE ajel_admission_wait_seconds summary\n";
+    writePrometheusSummary(out, "ajel_admission_wait_seconds", "", snap.admissionWait);
+    out << "# HELP ajel_turnaround_seconds Process turnaround (end - start).\n";
+    out << "# TYPE ajel_turnaround_seconds summary\n";
+    writePrometheusSummary(out, "ajel_turnaround_seconds", "", snap.turnaround);
+    out << "# HELP ajel_page_in_wait_seconds Time a process spends blocked on an async swap-in.\n";
+    out << "# TYPE ajel_page_in_wait_seconds summary\n";
+    writePrometheusSummary(out, "ajel_page_in_wait_seconds", "", snap.pageInWait);
+    out << "# HELP ajel_instruction_exec_seconds Instruction execution time by type.\n";
+    out << "# TYPE ajel_instruction_exec_seconds summary\n";
+    for (int type = 0; type < INSTRUCTION_TYPE_COUNT; ++type) {
+        if (type == ProcessInstruction::FOR_LOOP) continue;
+        writePrometheusSummary(out, "ajel_instruction_exec_seconds",
+            string("type=\"") + instructionTypeName(type) + "\"", snap.instructionExec[type]);
+    }
+}
+
+/**
+ * Writes the Prometheus file through a temporary file and a rename, so a
+ * scraper never reads a half-written file.
+ */
+bool exportMetricsFile(const string& path) {
+    string tmpPath = path + ".tmp";
+    {
+        ofstream outFile(tmpPath);
+        if (!outFile.is_open()) return false;
+        writeMetricsPrometheus(outFile, captureMetricsSnapshot());
+    }
+#ifdef _WIN32
+    return MoveFileExA(tmpPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return rename(tmpPath.c_str(), path.c_str()) == 0;
+#endif
+}
+
+/**
+ * Exporter thread: rewrites the Prometheus file every metrics-export-interval ms.
+ */
+void metricsExporterMain() {
+    unique_lock<mutex> lock(metrics_exporter_mutex);
+    while (isMetricsExporterRunning) {
+        lock.unlock();
+        exportMetricsFile(systemConfig.metrics_export_file);
+        lock.lock();
+        metrics_exporter_cv.wait_for(lock, chrono::milliseconds(systemConfig.metrics_export_interval),
+            [] { return !isMetricsExporterRunning; });
+    }
+    lock.unlock();
+    exportMetricsFile(systemConfig.metrics_export_file); // Final values on shutdown
+}
+
+void startMetricsExporter() {
+    if (systemConfig.metrics_export_interval <= 0 || isMetricsExporterRunning) return;
+    isMetricsExporterRunning = true;
+    metricsExporterThread = thread(metricsExporterMain);
+}
+
+void stopMetricsExporter() {
+    {
+        lock_guard<mutex> lock(metrics_exporter_mutex);
+        isMetricsExporterRunning = false;
+    }
+    metrics_exporter_cv.notify_all();
+    if (metricsExporterThread.joinable()) {
+        metricsExporterThread.join();
+    }
+}
+
+void printEnhancedVMStat() {
+    MetricsSnapshot snap = captureMetricsSnapshot();
+
+    long long totalMemBytes = snap.totalMemBytes;
+    long long usedMemBytes = snap.usedMemBytes;
+    long long freeMemBytes = totalMemBytes - usedMemBytes;
+    int freeFrames = snap.totalFrames - snap.usedFrames;
+
+    cout << "\n" << string(50, '=') << endl;
+    cout << "           VIRTUAL MEMORY STATISTICS" << endl;
+    cout << string(50, '=') << endl;
+
+    cout << "\n[MEMORY USAGE]" << endl;
+    cout << "Total Memory         : " << setw(10) << totalMemBytes << " bytes" << endl;
+    cout << "Used Memory          : " << setw(10) << usedMemBytes << " bytes" << endl;
+    cout << "Free Memory          : " << setw(10) << freeMemBytes << " bytes" << endl;
+    cout << "Memory Utilization   : " << setw(9) << fixed << setprecision(1)
+        << (totalMemBytes > 0 ? (double)usedMemBytes / totalMemBytes * 100 : 0) << "%" << endl;
+
+    cout << "\n[FRAME STATISTICS]" << endl;
+    cout << "Total Frames         : " << setw(10) << snap.totalFrames << endl;
+    cout << "Used Frames          : " << setw(10) << snap.usedFrames << endl;
+    cout << "Free Frames          : " << setw(10) << freeFrames << endl;
+    cout << "Dirty Frames         : " << setw(10) << snap.dirtyFrames << endl;
+    cout << "Frame Size           : " << setw(10) << snap.frameSize << " KB" << endl;
+
+    cout << "\n[CPU STATISTICS]" << endl;
+    cout << "Total CPU Ticks      : " << setw(10) << snap.totalCpuTicks << endl;
+    cout << "Active CPU Ticks     : " << setw(10) << snap.activeCpuTicks << endl;
+    cout << "Idle CPU Ticks       : " << setw(10) << snap.idleCpuTicks << endl;
+    cout << "CPU Utilization      : " << setw(9) << fixed << setprecision(1)
+        << (snap.totalCpuTicks > 0 ? (double)snap.activeCpuTicks / snap.totalCpuTicks * 100 : 0) << "%" << endl;
+
+    cout << "\n[PAGING STATISTICS]" << endl;
+    cout << "Page Faults          : " << setw(10) << snap.pageFaults << endl;
+    cout << "  Paged In           : " << setw(10) << snap.pagesPagedIn << endl;
+    cout << "  Zero-Fill          : " << setw(10) << snap.zeroFillFaults << endl;
+    cout << "  Copy-on-Write      : " << setw(10) << snap.cowFaults << endl;
+    cout << "Pages Paged Out      : " << setw(10) << snap.pagesPagedOut << endl;
+    cout << "COW Page Copies      : " << setw(10) << snap.cowPageCopies << endl;
+    cout << "Swap Read Calls      : " << setw(10) << snap.swapReadCalls << endl;
+    cout << "Swap Write Calls     : " << setw(10) << snap.swapWriteCalls << endl;
+    cout << "Async Page-Ins       : " << setw(10) << snap.asyncPageIns << endl;
+    if (snap.compressedPoolCapacity > 0) {
+        cout << "Compressed Pool      : " << setw(10) << snap.compressedPoolBytes << " / "
+            << snap.compressedPoolCapacity << " bytes (" << snap.compressedPoolPages << " pages)" << endl;
+        cout << "  Pages Stored       : " << setw(10) << snap.pagesCompressed << endl;
+        cout << "  Pool Hits          : " << setw(10) << snap.compressedPoolHits << endl;
+        cout << "  Spilled to Disk    : " << setw(10) << snap.pagesSpilled << endl;
+    }
+    cout << "Pages Prefetched     : " << setw(10) << snap.pagesPrefetched << endl;
+    cout << "Prefetch Hit Rate    : " << setw(9) << fixed << setprecision(1)
+        << (snap.pagesPrefetched > 0 ? (double)snap.prefetchHits / snap.pagesPrefetched * 100 : 0) << "%" << endl;
+    cout << "Page Fault Rate      : " << setw(9) << fixed << setprecision(3)
+        << (snap.totalCpuTicks > 0 ? (double)snap.pageFaults / snap.totalCpuTicks : 0) << endl;
+
+    cout << "\n[PROCESS STATISTICS]" << endl;
+    cout << "Running Processes    : " << setw(10) << snap.runningProcs << endl;
+    cout << "  Blocked on I/O     : " << setw(10) << snap.blockedProcs << endl;
+    cout << "Waiting Processes    : " << setw(10) << snap.waitingProcs << endl;
+    cout << "Finished Processes   : " << setw(10) << snap.finishedProcs << endl;
+    cout << "Total Processes      : " << setw(10) << snap.totalProcs << endl;
+    cout << "  Forked             : " << setw(10) << snap.forkedProcs << endl;
+    cout << "Program Images       : " << setw(10) << snap.programImages
+        << " (" << snap.programCacheHits << " shared)" << endl;
+
+    cout << "\n" << string(50, '=') << endl;
+}
+
+/**
+ * Writes one percentile row of the latency report. Values are shown in ms.
+ */
+void writeLatencyRow(ostream& out, const string& label, const LatencyHistogram& hist) {
+    auto ms = [](double micros) { return micros / 1000.0; };
+
+    out << left << setw(18) << label << right << setw(9) << hist.count()
+        << fixed << setprecision(3)
+        << setw(11) << ms(static_cast<double>(hist.minimum()))
+        << setw(11) << ms(hist.mean())
+        << setw(11) << ms(static_cast<double>(hist.percentile(50)))
+        << setw(11) << ms(static_cast<double>(hist.percentile(90)))
+        << setw(11) << ms(static_cast<double>(hist.percentile(99)))
+        << setw(11) << ms(static_cast<double>(hist.percentile(99.9)))
+        << setw(11) << ms(static_cast<double>(hist.maximum())) << endl;
+}
+
+/**
+ * Writes the latency percentiles (perf-stats) to the given stream.
+ * Only reads the lock-free histograms, so it never blocks the CPU workers.
+ */
+void writeLatencyReport(ostream& out) {
+    out << "LATENCY PERCENTILES (ms)" << endl;
+    out << string(106, '=') << endl;
+    out << left << setw(18) << "Metric" << right << setw(9) << "Count"
+        << setw(11) << "Min" << setw(11) << "Mean" << setw(11) << "p50" << setw(11) << "p90"
+        << setw(11) << "p99" << setw(11) << "p99.9" << setw(11) << "Max" << endl;
+    out << string(106, '-') << endl;
+
+    writeLatencyRow(out, "Ready-queue wait", readyQueueWaitHist);
+    writeLatencyRow(out, "Admission wait", admissionWaitHist);
+    writeLatencyRow(out, "Turnaround", turnaroundHist);
+    writeLatencyRow(out, "Page-in wait", pageInWaitHist);
+
+    out << string(106, '-') << endl;
+    for (int type = 0; type < INSTRUCTION_TYPE_COUNT; ++type) {
+        if (type == ProcessInstruction::FOR_LOOP) continue; // Never dispatched on its own
+        writeLatencyRow(out, string("Exec ") + instructionTypeName(type), instructionExecHist[type]);
+    }
+    out << string(106, '=') << endl;
+    out << defaultfloat;
+}
+
+/**
+ * Displays the Scheduler UI, showing running and finished processes.
+ * REVISED to show memory usage and waiting processes.
+ * Reads the published process status, so it never blocks the CPU workers.
+ */
+void displaySchedulerUI() {
+#ifdef _WIN32
+    system("cls");
+#else
+    system("clear");
+#endif
+
+    displayHeader();
+
+    vector<ProcessStatusView> processes = snapshotAllProcesses(REPORT_RECENT_RETIRED);
+    int memoryUsed = current_memory_used.load();
+
+    // Calculate CPU utilization and process statistics
+    int totalCores = systemConfig.num_cpu;
+    int coresUsed = 0;
+    int runningProcesses = 0;
+    int waitingProcesses = 0;
+    int finishedListed = 0;
+    vector<bool> coreInUse(totalCores, false);
+
+    for (const auto& process : processes) {
+        if (process.state == ProcessStatusView::FINISHED || process.state == ProcessStatusView::VIOLATION) {
+            finishedListed++;
+        }
+        else if (process.state == ProcessStatusView::RUNNING) {
+            runningProcesses++;
+            if (process.core != -1 && process.core < totalCores) {
+                coreInUse[process.core] = true;
+            }
+        }
+        else if (process.state == ProcessStatusView::BLOCKED) {
+            runningProcesses++; // Started, but holds no core until its swap-in completes
+        }
+        else {
+            // Otherwise, it's waiting for memory.
+            waitingProcesses++;
+        }
+    }
+
+    for (bool inUse : coreInUse) {
+        if (inUse) coresUsed++;
+    }
+
+    // Older retired processes are only counted, from the history counters
+    int finishedProcesses = max(processesFinished.load(), finishedListed);
+    size_t totalProcesses = processes.size() - finishedListed + finishedProcesses;
+
+    int coresAvailable = totalCores - coresUsed;
+    double cpuUtilization = totalCores > 0 ? (static_cast<double>(coresUsed) / totalCores) * 100.0 : 0.0;
+    double memUtilization = systemConfig.max_overall_mem > 0 ? (static_cast<double>(memoryUsed) / systemConfig.max_overall_mem) * 100.0 : 0.0;
+
+    cout << "SYSTEM STATUS REPORT" << endl;
+    cout << "======================================" << endl;
+    cout << "CPU Utilization: " << fixed << setprecision(2) << cpuUtilization << "%" << endl;
+    cout << "Memory Utilization: " << memoryUsed << " / " << systemConfig.max_overall_mem
+        << " KB (" << fixed << setprecision(2) << memUtilization << "%)" << endl;
+    cout << "Cores used: " << coresUsed << " | Cores available: " << coresAvailable << " | Total cores: " << totalCores << endl;
+    cout << endl;
+
+    cout << "Running processes:" << endl;
+    if (runningProcesses == 0) {
+        cout << "No running processes." << endl;
+    }
+    else {
+        for (const auto& p : processes) {
+            if (p.state == ProcessStatusView::RUNNING || p.state == ProcessStatusView::BLOCKED) {
+                cout << left << setw(12) << p.name;
+                cout << " (" << setw(25) << formatStatusTime(p.startTime) << ")";
+                cout << right << setw(8) << "Core: "
+                    << (p.state == ProcessStatusView::BLOCKED ? "I/O" : p.core == -1 ? "N/A" : to_string(p.core));
+                cout << setw(8) << p.tasksCompleted << " / " << p.totalTasks << endl;
+            }
+        }
+    }
+
+    cout << endl << "Waiting for Memory:" << endl;
+    if (waitingProcesses == 0) {
+        cout << "No processes waiting for memory." << endl;
+    }
+    else {
+        for (const auto& p : processes) {
+            if (p.state == ProcessStatusView::WAITING) {
+                cout << left << setw(12) << p.name;
+                cout << " (Requires: " << p.memorySize << " KB)" << endl;
+            }
+        }
+    }
+
+
+    cout << endl << "Finished processes:" << endl;
+    if (finishedProcesses == 0) {
+        cout << "No finished processes." << endl;
+    }
+    else {
+        for (const auto& p : processes) {
+            if (p.state == ProcessStatusView::FINISHED || p.state == ProcessStatusView::VIOLATION) {
+                cout << left << setw(12) << p.name << " (";
+                cout << setw(25) << formatStatusTime(p.endTime) << ")";
+                cout << right << setw(8) << "Core: " << p.core;
+                // === [MODIFIED] === Display memory violation status
+                if (p.state == ProcessStatusView::VIOLATION) {
+                    cout << right << setw(12) << "VIOLATION";
+                }
+                else {
+                    cout << right << setw(12) << "Finished";
+                }
+                cout << setw(8) << p.tasksCompleted << " / " << p.totalTasks << endl;
+            }
+        }
+        if (finishedProcesses > finishedListed) {
+            cout << "... and " << finishedProcesses - finishedListed << " earlier (report-util --all lists every process)" << endl;
+        }
+    }
+
+    cout << endl << "======================================" << endl;
+    cout << "Total processes: " << totalProcesses << endl;
+    cout << "Running: " << runningProcesses << " | Waiting: " << waitingProcesses << " | Finished: " << finishedProcesses << endl;
+    cout << "======================================" << endl;
+}
+
+void displayHeader() {
+    cout << R"(
+    _____           ____. ___________ .____         ________      _________
+   /  _  \         |    | \_   _____/ |    |        \_____  \    /   _____/
+  /  /_\  \        |    |  |    __)_  |    |         /   |   \   \_____  \ 
+ /    |    \   /\__|    |  |        \ |    |___     /    |    \  /        \
+ \____|__  /   \________| /_________/ |________\    \_______  / /_________/
+         \/                                                 \/             
+)" << endl;
+}
+
+/**
+ * Generate CPU utilization report and save to csopesy-log.txt. Like screen -ls it
+ * lists only the most recent retired processes unless allRetired is set.
+ */
+void generateUtilizationReport(bool allRetired) {
+    vector<ProcessStatusView> processes = snapshotAllProcesses(allRetired ? SIZE_MAX : REPORT_RECENT_RETIRED);
+    int memoryUsed = current_memory_used.load();
+
+    // Calculate CPU utilization statistics
+    int totalCores = systemConfig.num_cpu;
+    int coresUsed = 0;
+    int runningProcesses = 0;
+    int finishedListed = 0;
+    int waitingProcesses = 0;
+
+    // Count cores in use and process statistics
+    vector<bool> coreInUse(totalCores, false);
+    for (const auto& process : processes) {
+        if (process.state == ProcessStatusView::FINISHED || process.state == ProcessStatusView::VIOLATION) {
+            finishedListed++;
+        }
+        else if (process.state == ProcessStatusView::RUNNING) {
+            runningProcesses++;
+            if (process.core != -1 && process.core < totalCores) {
+                coreInUse[process.core] = true;
+            }
+        }
+        else if (process.state == ProcessStatusView::BLOCKED) {
+            runningProcesses++; // Started, but holds no core until its swap-in completes
+        }
+        else {
+            waitingProcesses++;
+        }
+    }
+
+    // Count cores actually in use
+    for (bool inUse : coreInUse) {
+        if (inUse) coresUsed++;
+    }
+
+    int finishedProcesses = max(processesFinished.load(), finishedListed);
+    size_t totalProcesses = processes.size() - finishedListed + finishedProcesses;
+
+    int coresAvailable = totalCores - coresUsed;
+    double cpuUtilization = totalCores > 0 ? (static_cast<double>(coresUsed) / totalCores) * 100.0 : 0.0;
+    double memUtilization = systemConfig.max_overall_mem > 0 ? (static_cast<double>(memoryUsed) / systemConfig.max_overall_mem) * 100.0 : 0.0;
+
+    // Generate timestamp for the report
+    time_t now = time(0);
+    tm localtm;
+#ifdef _WIN32
+    localtime_s(&localtm, &now);
+#else
+    localtime_r(&now, &localtm);
+#endif
+    stringstream timestamp;
+    timestamp << put_time(&localtm, "%m/%d/%Y, %I:%M:%S %p");
+
+    // Write report to file
+    ofstream reportFile("csopesy-log.txt");
+    if (!reportFile.is_open()) {
+        cout << "Error: Could not create csopesy-log.txt file." << endl;
+        return;
+    }
+
+    // Write the exact same format as screen -ls
+    reportFile << "SYSTEM STATUS REPORT" << endl;
+    reportFile << "Generated: " << timestamp.str() << endl;
+    reportFile << "======================================" << endl;
+    reportFile << "CPU Utilization: " << fixed << setprecision(2) << cpuUtilization << "%" << endl;
+    reportFile << "Memory Utilization: " << memoryUsed << " / " << systemConfig.max_overall_mem
+        << " KB (" << fixed << setprecision(2) << memUtilization << "%)" << endl;
+    reportFile << "Cores used: " << coresUsed << " | Cores available: " << coresAvailable << " | Total cores: " << totalCores << endl;
+    reportFile << endl;
+
+
+    // Write running processes
+    reportFile << "Running processes:" << endl;
+    if (runningProcesses == 0) {
+        reportFile << "No running processes." << endl;
+    }
+    else {
+        for (const auto& p : processes) {
+            if (p.state == ProcessStatusView::RUNNING || p.state == ProcessStatusView::BLOCKED) {
+                reportFile << left << setw(12) << p.name;
+                reportFile << " (" << setw(25) << formatStatusTime(p.startTime) << ")";
+                reportFile << right << setw(8) << "Core: "
+                    << (p.state == ProcessStatusView::BLOCKED ? "I/O" : p.core == -1 ? "N/A" : to_string(p.core));
+                reportFile << setw(8) << p.tasksCompleted << " / " << p.totalTasks << endl;
+            }
+        }
+    }
+
+    reportFile << endl << "Waiting for Memory:" << endl;
+    if (waitingProcesses == 0) {
+        reportFile << "No processes waiting for memory." << endl;
+    }
+    else {
+        for (const auto& p : processes) {
+            if (p.state == ProcessStatusView::WAITING) {
+                reportFile << left << setw(12) << p.name;
+                reportFile << " (Requires: " << p.memorySize << " KB)" << endl;
+            }
+        }
+    }
+
+
+    reportFile << endl << "Finished processes:" << endl;
+    if (finishedProcesses == 0) {
+        reportFile << "No finished processes." << endl;
+    }
+    else {
+        for (const auto& p : processes) {
+            if (p.state == ProcessStatusView::FINISHED || p.state == ProcessStatusView::VIOLATION) {
+                reportFile << left << setw(12) << p.name << " (";
+                reportFile << setw(25) << formatStatusTime(p.endTime) << ")";
+                reportFile << right << setw(8) << "Core: " << p.core;
+                if (p.state == ProcessStatusView::VIOLATION) {
+                    reportFile << right << setw(12) << "VIOLATION";
+                }
+                else {
+                    reportFile << right << setw(12) << "Finished";
+                }
+                reportFile << setw(8) << p.tasksCompleted << " / " << p.totalTasks << endl;
+            }
+        }
+        if (finishedProcesses > finishedListed) {
+            reportFile << "... and " << finishedProcesses - finishedListed << " earlier (report-util --all lists every process)" << endl;
+        }
+    }
+
+    reportFile << endl << "======================================" << endl;
+    reportFile << "Total processes: " << totalProcesses << endl;
+    reportFile << "Running: " << runningProcesses << " | Waiting: " << waitingProcesses << " | Finished: " << finishedProcesses << endl;
+    reportFile << "======================================" << endl;
+
+    reportFile << endl;
+    writeLatencyReport(reportFile);
+
+    reportFile.close();
+
+    cout << "System status report generated and saved to csopesy-log.txt" << endl;
+}
+
+// =================== Reports - END =================== //
@@ -0,0 +1,781 @@
+/** === AJEL OS: scheduler ===
+ * Process lifecycle, the CPU workers, memory admission, fork and batch submission.
+ */
+
+#include "ajel.h"
+
+// ===================== Scheduler ===================== //
+
+/**
+ * Adds process statuses to the registry read by the status reporters.
+ * Takes a batch so bulk creation copies the registry only once.
+ */
+void registerProcessStatuses(const vector<shared_ptr<ProcessStatus>>& statuses) {
+    if (statuses.empty()) return;
+    lock_guard<mutex> lock(statusRegistryMutex);
+    auto updated = make_shared<vector<shared_ptr<ProcessStatus>>>(*atomic_load(&processStatusRegistry));
+    updated->insert(updated->end(), statuses.begin(), statuses.end());
+    atomic_store(&processStatusRegistry, shared_ptr<const vector<shared_ptr<ProcessStatus>>>(move(updated)));
+}
+
+/**
+ * Reads a consistent view of every process without blocking the CPU workers.
+ */
+vector<ProcessStatusView> snapshotProcessStatuses() {
+    auto registry = atomic_load(&processStatusRegistry);
+    vector<ProcessStatusView> views;
+    views.reserve(registry->size());
+    for (const auto& status : *registry) {
+        views.push_back(status->read());
+    }
+    return views;
+}
+
+/**
+ * Summaries of the last limit retired processes that are not already in live
+ * (a process can be in both while it is being retired). Only those entries are
+ * copied under processArchiveMutex, so retiring workers never wait on a copy
+ * of the whole history.
+ */
+vector<ProcessStatusView> snapshotRetiredProcesses(const vector<ProcessStatusView>& live, size_t limit) {
+    unordered_set<int> finishedLive;
+    for (const auto& view : live) {
+        if (view.state == ProcessStatusView::FINISHED || view.state == ProcessStatusView::VIOLATION) {
+            finishedLive.insert(view.pid);
+        }
+    }
+
+    lock_guard<mutex> lock(processArchiveMutex);
+    size_t first = processArchive.size() - min(limit, processArchive.size());
+    vector<ProcessStatusView> retired;
+    retired.reserve(processArchive.size() - first);
+    for (size_t i = first; i < processArchive.size(); i++) {
+        if (!finishedLive.count(processArchive[i].pid)) retired.push_back(processArchive[i]);
+    }
+    return retired;
+}
+
+/**
+ * Live processes followed by the last retiredLimit retired ones, for the
+ * reports that list history. Pass SIZE_MAX for the whole archive.
+ */
+vector<ProcessStatusView> snapshotAllProcesses(size_t retiredLimit) {
+    vector<ProcessStatusView> processes = snapshotProcessStatuses();
+    vector<ProcessStatusView> retired = snapshotRetiredProcesses(processes, retiredLimit);
+    processes.insert(processes.end(), make_move_iterator(retired.begin()), make_move_iterator(retired.end()));
+    return processes;
+}
+
+/**
+ * Formats a time_t the way the status reports show it.
+ */
+string formatStatusTime(time_t value) {
+    tm localtm;
+#ifdef _WIN32
+    localtime_s(&localtm, &value);
+#else
+    localtime_r(&value, &localtm);
+#endif
+    stringstream ss;
+    ss << put_time(&localtm, "%m/%d/%Y %I:%M:%S%p");
+    return ss.str();
+}
+
+void releaseProcessFrames(Process* process) {
+    lock_guard<mutex> lock(frameTableMutex);
+    for (auto const& [vpn, page_entry] : process->pageTable) {
+        if (page_entry.valid) {
+            int frameNum = page_entry.frameNumber;
+            if (frameNum >= 0 && frameNum < frameTable.size()) {
+                // A frame shared copy-on-write stays with the remaining sharers
+                FrameInfo& frame = frameTable[frameNum];
+                auto sharer = find(frame.sharers.begin(), frame.sharers.end(), process);
+                if (sharer != frame.sharers.end()) {
+                    frame.sharers.erase(sharer);
+                }
+                else if (!frame.sharers.empty()) {
+                    frame.owner = frame.sharers.back();
+                    frame.ownerPID = frame.owner->pid;
+                    frame.sharers.pop_back();
+                }
+                else {
+                    resetFrame(frame);
+                }
+            }
+            process->status->residentPages--;
+        }
+    }
+}
+
+/**
+ * Drops registry entries whose summaries are already archived. Copying the
+ * registry is O(live processes), so it is only done once at least half of it
+ * is archived. Call with statusRegistryMutex held.
+ */
+void pruneStatusRegistry() {
+    auto registry = atomic_load(&processStatusRegistry);
+    if (archivedInRegistry * 2 < static_cast<int>(registry->size())) return;
+
+    auto updated = make_shared<vector<shared_ptr<ProcessStatus>>>();
+    updated->reserve(registry->size() - archivedInRegistry);
+    for (const auto& status : *registry) {
+        if (!status->archived.load()) updated->push_back(status);
+    }
+    atomic_store(&processStatusRegistry, shared_ptr<const vector<shared_ptr<ProcessStatus>>>(move(updated)));
+    archivedInRegistry = 0;
+}
+
+/**
+ * Moves a finished process into processArchive and destroys it, freeing its
+ * arena, program and page table. Its frames must already be released.
+ * Called by the worker that finished it; the pointer is invalid afterwards.
+ */
+void retireProcess(Process* process) {
+    if (pendingForkCount.load() > 0) {
+        lock_guard<mutex> lock(pendingForksMutex);
+        auto it = pendingForks.find(process->pid);
+        if (it != pendingForks.end()) {
+            pendingForkCount -= static_cast<int>(it->second.size());
+            pendingForks.erase(it);
+        }
+    }
+    compressedPool.release(*process, process->memorySize / systemConfig.mem_per_frame);
+    swapDevice.release(*process, process->memorySize / systemConfig.mem_per_frame);
+    shared_ptr<ProcessStatus> status = process->status;
+    {
+        lock_guard<mutex> lock(processArchiveMutex);
+        processArchive.push_back(status->read());
+    }
+    {
+        // Flag and count together, or a concurrent prune could drop the entry before it is counted
+        lock_guard<mutex> lock(statusRegistryMutex);
+        status->archived = true;
+        archivedInRegistry++;
+        pruneStatusRegistry();
+    }
+    {
+        lock_guard<mutex> lock(processMutex);
+        globalProcesses.erase(process->pid);
+    }
+}
+
+/**
+ * Creates child as a copy of parent at its current instruction. The program
+ * and symbol table are copied; memory is shared copy-on-write: every
+ * resident frame is mapped by both, and neither needs I/O to fault in a
+ * shared page later, so the cost is O(page table). Only the thread that owns
+ * parent may call this. Returns nullptr if the name is taken.
+ */
+Process* forkProcess(Process& parent, const string& childName) {
+    Process* child = nullptr;
+    {
+        lock_guard<mutex> create_lock(processMutex);
+        lock_guard<mutex> screen_lock(screensMutex);
+        if (screens.count(childName)) return nullptr;
+        for (const auto& [pid, p] : globalProcesses) {
+            if (p.name == childName) return nullptr;
+        }
+
+        int pid = nextPID++;
+        Process proc(childName, parent.memorySize, pid);
+        proc.program = parent.program;
+        if (parent.generator) {
+            // Sized for any later chunk, as in createGeneratedProcess; growing would strand arena blocks
+            proc.instructions.reserve(max(parent.instructions.size(), static_cast<size_t>(systemConfig.instruction_chunk_size + 1)));
+        }
+        proc.instructions.assign(parent.instructions.begin(), parent.instructions.end());
+        proc.symbolSlots.insert(parent.symbolSlots.begin(), parent.symbolSlots.end());
+        memcpy(proc.symbolTable, parent.symbolTable, sizeof(proc.symbolTable));
+        proc.declaredSlots = parent.declaredSlots;
+        proc.currentInstructionIndex = parent.currentInstructionIndex;
+        proc.tasksCompleted = parent.tasksCompleted;
+        proc.totalTasks = parent.totalTasks;
+        proc.chunkBase = parent.chunkBase;
+        proc.instructionsToGenerate = parent.instructionsToGenerate;
+        if (parent.generator) proc.generator = make_shared<WorkloadGenerator>(*parent.generator);
+
+        screens[childName] = Screen(childName, parent.memorySize, parent.totalTasks);
+        proc.publishStatus();
+        registerProcessStatuses({ proc.status });
+        child = &globalProcesses.emplace(pid, move(proc)).first->second;
+        processesCreated++;
+        processesForked++;
+    }
+
+    {
+        lock_guard<mutex> lock(frameTableMutex);
+        {
+            lock_guard<mutex> memory_lock(*parent.memoryMutex);
+            parent.memory.shareWith(child->memory);
+        }
+        for (auto& [vpn, entry] : parent.pageTable) {
+            PageTableEntry& childEntry = child->pageTable[vpn];
+            childEntry.virtualPageNumber = vpn;
+            bool resident = entry.valid && entry.frameNumber >= 0 && entry.frameNumber < static_cast<int>(frameTable.size()) &&
+                frameTable[entry.frameNumber].owner == &parent && frameTable[entry.frameNumber].virtualPageNumber == vpn;
+            if (!resident && !parent.memory.isShared(vpn)) continue; // Never touched: both stay demand-zero
+
+            // The shared copy in memory supersedes any swap copy, and no longer needs writing back
+            entry.cow = childEntry.cow = true;
+            entry.hasSwapCopy = false;
+            if (!resident) continue;
+
+            FrameInfo& frame = frameTable[entry.frameNumber];
+            if (frame.dirty) dirtyFrameCount--;
+            frame.dirty = false;
+            entry.dirty = false;
+            frame.sharers.push_back(child);
+            childEntry.frameNumber = entry.frameNumber;
+            childEntry.valid = true;
+            childEntry.referenced = true;
+            child->status->residentPages++;
+        }
+    }
+    compressedPool.release(parent, parent.memorySize / systemConfig.mem_per_frame); // Superseded by the shared copy
+
+    {
+        lock_guard<mutex> wait_lock(waiting_queue_mutex);
+        child->admissionEnqueuedAt = chrono::steady_clock::now();
+        waiting_for_memory_queue.push(child);
+        waitingQueueDepth++;
+    }
+    memory_cv.notify_one();
+    return child;
+}
+
+/**
+ * Runs the screen -f requests queued for parent. Called by the worker that
+ * owns it, at the end of its time slice.
+ */
+void runPendingForks(Process& parent, ofstream& logFile, int coreId) {
+    vector<string> children;
+    {
+        lock_guard<mutex> lock(pendingForksMutex);
+        auto it = pendingForks.find(parent.pid);
+        if (it == pendingForks.end()) return;
+        children = move(it->second);
+        pendingForks.erase(it);
+        pendingForkCount -= static_cast<int>(children.size());
+    }
+
+    time_t now = time(0);
+    tm localtm;
+#ifdef _WIN32
+    localtime_s(&localtm, &now);
+#else
+    localtime_r(&now, &localtm);
+#endif
+    stringstream timestamp;
+    timestamp << put_time(&localtm, "(%m/%d/%Y %I:%M:%S %p)");
+
+    for (const string& name : children) {
+        Process* child = forkProcess(parent, name);
+        if (child) {
+            logFile << timestamp.str() << " Core:" << coreId << " FORK " << name << " (PID " << child->pid
+                << ") at instruction " << parent.tasksCompleted << endl;
+        }
+        else {
+            logFile << timestamp.str() << " Core:" << coreId << " FORK " << name << " failed. Name already in use." << endl;
+        }
+    }
+}
+
+/**
+ * Parses a user process memory size: a power of two from 64 to 65536 bytes.
+ */
+bool parseProcessMemory(const string& text, int& memorySize) {
+    try {
+        memorySize = stoi(text);
+    }
+    catch (...) {
+        return false;
+    }
+    return memorySize >= 64 && memorySize <= 65536 && (memorySize & (memorySize - 1)) == 0;
+}
+
+/**
+ * Builds a user-defined process that runs program, with an empty page table.
+ */
+Process createUserProcess(const string& name, int memorySize, int pid, shared_ptr<const ProgramImage> program) {
+    Process newProc(name, memorySize, pid);
+    newProc.totalTasks = program->totalTasks;
+    newProc.program = move(program);
+
+    // Initialize Page Table
+    int numPages = memorySize / systemConfig.mem_per_frame;
+    newProc.pageTable.reserve(numPages);
+    for (int vpn = 0; vpn < numPages; ++vpn) {
+        PageTableEntry& entry = newProc.pageTable[vpn];
+        entry.virtualPageNumber = vpn;
+        entry.valid = false; // Page not yet in memory
+        entry.frameNumber = -1;
+        entry.dirty = false;
+        entry.referenced = false;
+    }
+
+    newProc.publishStatus();
+    return newProc;
+}
+
+/**
+ * One process definition from a submit file. A line holds the same
+ * arguments as screen -c: <name> <mem> "<instructions>".
+ */
+struct JobDefinition {
+    int line = 0;
+    string name;
+    int memorySize = 0;
+    shared_ptr<const ProgramImage> program; // Null if the line was rejected
+    string error;
+};
+
+/**
+ * Parses text into job. On failure job.program stays null and job.error says why.
+ */
+void parseJobLine(const string& text, JobDefinition& job) {
+    stringstream ss(text);
+    string mem_str;
+    ss >> job.name >> mem_str;
+
+    size_t first_quote = text.find('"');
+    size_t last_quote = text.rfind('"');
+    if (job.name.empty() || mem_str.empty() || first_quote == string::npos || first_quote == last_quote) {
+        job.error = "Expected <name> <mem> \"<instructions>\"";
+        return;
+    }
+    if (!parseProcessMemory(mem_str, job.memorySize)) {
+        job.error = "Invalid memory allocation";
+        return;
+    }
+
+    stringstream errors;
+    job.program = compileProgram(text.substr(first_quote + 1, last_quote - first_quote - 1), errors);
+    if (!job.program) {
+        job.error = errors.str();
+        if (!job.error.empty() && job.error.back() == '\n') job.error.pop_back();
+    }
+}
+
+/**
+ * Creates a process for every definition in path. Lines are parsed on all
+ * hardware threads, and identical programs only once (see compileProgram).
+ * The processes are then added under one acquisition of processMutex and
+ * screensMutex and queued for admission in a single push. Blank lines and
+ * lines starting with # are skipped. Returns the number of processes
+ * submitted, or -1 if the file cannot be read.
+ */
+int submitJobFile(const string& path) {
+    ifstream file(path);
+    if (!file.is_open()) {
+        cout << "Error: Could not open " << path << "." << endl;
+        return -1;
+    }
+
+    auto started = chrono::steady_clock::now();
+    vector<JobDefinition> jobs;
+    vector<string> lines;
+    string text;
+    for (int lineNumber = 1; getline(file, text); ++lineNumber) {
+        size_t first = text.find_first_not_of(" \t\r");
+        if (first == string::npos || text[first] == '#') continue;
+        jobs.emplace_back();
+        jobs.back().line = lineNumber;
+        lines.push_back(move(text));
+    }
+
+    // Parse in parallel; each thread owns a contiguous range of jobs
+    int count = static_cast<int>(jobs.size());
+    int threadCount = static_cast<int>(thread::hardware_concurrency());
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > count / 64 + 1) threadCount = count / 64 + 1; // Not worth a thread for tiny files
+    int perThread = (count + threadCount - 1) / max(1, threadCount);
+    vector<thread> parsers;
+    for (int t = 0; t < threadCount; ++t) {
+        int begin = t * perThread;
+        int end = min(count, begin + perThread);
+        parsers.emplace_back([&jobs, &lines, begin, end] {
+            for (int i = begin; i < end; ++i) parseJobLine(lines[i], jobs[i]);
+            });
+    }
+    for (auto& parser : parsers) {
+        parser.join();
+    }
+
+    // Report rejected lines in file order, and names repeated within the file
+    int rejected = 0;
+    unordered_set<string> fileNames;
+    auto reject = [&rejected, &path](const JobDefinition& job, const string& reason) {
+        if (rejected++ < 10) cout << path << ":" << job.line << ": " << reason << endl;
+    };
+    vector<JobDefinition*> accepted;
+    accepted.reserve(jobs.size());
+    for (auto& job : jobs) {
+        if (!job.program) reject(job, job.error);
+        else if (!fileNames.insert(job.name).second) reject(job, "Duplicate process name \"" + job.name + "\"");
+        else accepted.push_back(&job);
+    }
+
+    int firstPid;
+    {
+        lock_guard<mutex> pid_lock(processMutex);
+        firstPid = nextPID;
+        nextPID += static_cast<int>(accepted.size());
+    }
+    vector<Process> created;
+    created.reserve(accepted.size());
+    for (size_t i = 0; i < accepted.size(); ++i) {
+        const JobDefinition& job = *accepted[i];
+        created.push_back(createUserProcess(job.name, job.memorySize, firstPid + static_cast<int>(i), job.program));
+    }
+
+    // Add them all at once - lock mutexes in consistent order
+    vector<Process*> admitted;
+    admitted.reserve(created.size());
+    {
+        lock_guard<mutex> create_add_lock(processMutex);
+        lock_guard<mutex> screen_lock(screensMutex);
+
+        unordered_set<string> existing;
+        for (const auto& [pid, p] : globalProcesses) existing.insert(p.name);
+
+        vector<shared_ptr<ProcessStatus>> newStatuses;
+        newStatuses.reserve(created.size());
+        for (size_t i = 0; i < created.size(); ++i) {
+            Process& proc = created[i];
+            if (screens.count(proc.name) || existing.count(proc.name)) {
+                reject(*accepted[i], "Process or screen with name \"" + proc.name + "\" already exists");
+                continue;
+            }
+            screens[proc.name] = Screen(proc.name, proc.memorySize, proc.totalTasks);
+            newStatuses.push_back(proc.status);
+            int pid = proc.pid;
+            admitted.push_back(&globalProcesses.emplace(pid, move(proc)).first->second);
+        }
+        processesCreated += static_cast<int>(admitted.size());
+        registerProcessStatuses(newStatuses);
+    }
+    if (rejected > 10) cout << "... and " << rejected - 10 << " more rejected lines." << endl;
+
+    if (!admitted.empty()) {
+        lock_guard<mutex> wait_lock(waiting_queue_mutex);
+        auto enqueuedAt = chrono::steady_clock::now();
+        for (Process* proc : admitted) {
+            proc->admissionEnqueuedAt = enqueuedAt;
+            waiting_for_memory_queue.push(proc);
+        }
+        waitingQueueDepth += static_cast<int>(admitted.size());
+    }
+    memory_cv.notify_one(); // Notify admission scheduler of the new processes
+
+    auto elapsedMs = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - started).count();
+    cout << "Submitted " << admitted.size() << " of " << jobs.size() << " processes from " << path
+        << " in " << elapsedMs << " ms. Now waiting for memory." << endl;
+    return static_cast<int>(admitted.size());
+}
+
+/**
+ * @brief This is the main function for each CPU worker thread.
+ * REVISED: When a process finishes, it now releases its memory and
+ * notifies the admission scheduler.
+ */
+void cpu_worker_main(int coreId) {
+    while (isSchedulerRunning) {
+        Process* currentProcess = nullptr;
+
+        // Get process from queue
+        {
+            unique_lock<mutex> lock(queue_mutex);
+            scheduler_cv.wait(lock, [] {
+                return !ready_queue.empty() || !isSchedulerRunning;
+                });
+
+            if (!isSchedulerRunning && ready_queue.empty()) {
+                return;
+            }
+            if (!ready_queue.empty()) {
+                currentProcess = ready_queue.front();
+                ready_queue.pop();
+                readyQueueDepth--;
+                readyQueueWaitHist.recordSince(currentProcess->readyEnqueuedAt);
+            }
+            else {
+                // Idle tick
+                totalCpuTicks++;
+                idleCpuTicks++;
+                continue;
+            }
+        }
+
+        if (currentProcess) {
+            // Set start time only once. This worker owns the process until it is
+            // re-queued, so no lock is needed; reporters read the published status.
+            if (currentProcess->startTime == 0) {
+                currentProcess->startTime = time(nullptr);
+                currentProcess->startClock = chrono::steady_clock::now();
+                processesStarted++;
+            }
+            currentProcess->core = coreId;  // Update current core
+            if (currentProcess->pendingPageIn) finishPageIn(*currentProcess);
+            currentProcess->publishStatus();
+
+            busyCoreCount++;
+            auto sliceStart = chrono::steady_clock::now();
+
+            // Open log file in append mode
+            string logFileName = currentProcess->name + ".txt";
+            ofstream outfile(logFileName, ios::app);
+
+            int executedInstructions = 0;
+            while (!systemConfig.scheduler.compare("fcfs") || executedInstructions < systemConfig.quantum_cycles) {
+
+                if (!isSchedulerRunning) break;
+
+                const ProcessInstruction* next = fetchNextInstruction(*currentProcess);
+                if (!next) break; // Program complete
+                const ProcessInstruction& instr = *next;
+                auto instrStart = chrono::steady_clock::now();
+                bool instrOk = executeInstruction(currentProcess, instr, coreId, outfile);
+                currentProcess->resumedFromPageIn = false;
+                instructionExecHist[instr.type].recordSince(instrStart);
+                if (!instrOk) {
+                    // Instruction caused termination (e.g., memory violation)
+                    break;
+                }
+                if (currentProcess->pendingPageIn) break; // Blocked on a swap-in; the instruction reruns on resume
+
+                currentProcess->currentInstructionIndex++;
+                currentProcess->publishStatus();
+
+                executedInstructions++;
+                instructionsExecuted++;
+                totalCpuTicks++;
+                activeCpuTicks++;
+                generateDetailedMemorySnapshot(quantumCycleCounter++);
+            }
+
+            // Deferred while a page-in is in flight so the child never inherits half-loaded pages
+            if (pendingForkCount.load() > 0 && !currentProcess->pendingPageIn) runPendingForks(*currentProcess, outfile, coreId);
+            outfile.close();
+
+            // Check if process finished
+            bool blocked = currentProcess->pendingPageIn != nullptr;
+            bool finished = false;
+            bool violation_occurred = false;
+            if (isProgramComplete(*currentProcess) || currentProcess->has_violation) {
+                currentProcess->endTime = time(nullptr);
+                currentProcess->endClock = chrono::steady_clock::now();
+                currentProcess->isFinished = true;
+                finished = true;
+                turnaroundHist.record(static_cast<uint64_t>(chrono::duration_cast<chrono::microseconds>(
+                    currentProcess->endClock - currentProcess->startClock).count()));
+                processesFinished++;
+                if (currentProcess->has_violation) {
+                    violation_occurred = true;
+                    processesViolated++;
+                }
+            }
+            currentProcess->publishStatus();
+
+            // If a violation occurred, update the screen so screen -r reports it
+            if (violation_occurred) {
+                lock_guard<mutex> screen_lock(screensMutex);
+                if (screens.count(currentProcess->name)) {
+                    screens.at(currentProcess->name).triggerMemoryViolation(currentProcess->violation_address);
+                }
+            }
+
+            busyCoreCount--;
+            coreBusyMicros[coreId] += chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - sliceStart).count();
+
+            // If finished, release memory and frames
+            if (finished) {
+                releaseProcessFrames(currentProcess);
+                retireProcess(currentProcess);
+                {
+                    lock_guard<mutex> mem_lock(memory_mutex);
+                    //current_memory_used -= currentProcess->memorySize;
+                }
+                memory_cv.notify_one(); // Signal that memory has been freed
+            }
+            else if (blocked) {
+                pageFaultService.submit(currentProcess); // Requeued when the read completes
+            }
+            // === [FIX] ===
+            // If the process is NOT finished and scheduler is RR, put it back on the queue.
+            else if (systemConfig.scheduler == "rr") {
+                {
+                    lock_guard<mutex> lock(queue_mutex);
+                    currentProcess->readyEnqueuedAt = chrono::steady_clock::now();
+                    ready_queue.push(currentProcess);
+                    readyQueueDepth++;
+                }
+                // Don't need to notify here, the worker will just loop and grab the next process.
+            }
+        }
+    }
+}
+
+/**
+ * @brief NEW function: The main admission scheduler thread function.
+ * This function admits processes from the waiting queue into the ready queue
+ * if there is enough available memory. It then lets the CPU workers handle
+ * execution.
+ */
+void admissionScheduler() {
+    // --- Start all CPU worker threads ---
+    cpu_workers.clear();
+    for (int i = 0; i < systemConfig.num_cpu; ++i) {
+        cpu_workers.emplace_back(cpu_worker_main, i);
+    }
+
+    // --- Main admission loop ---
+    vector<Process*> to_admit;
+    while (isSchedulerRunning) {
+        to_admit.clear();
+        {
+            // Admission no longer checks memory usage (see below), so only the waiting queue is locked
+            lock_guard<mutex> wait_lock(waiting_queue_mutex);
+
+            // ALWAYS admit every waiting process. Let the page allocator handle memory.
+            while (!waiting_for_memory_queue.empty()) {
+                Process* next_proc = waiting_for_memory_queue.front();
+                waiting_for_memory_queue.pop();
+                admissionWaitHist.recordSince(next_proc->admissionEnqueuedAt);
+                to_admit.push_back(next_proc);
+            }
+            waitingQueueDepth -= static_cast<int>(to_admit.size());
+        }
+
+        if (!to_admit.empty()) {
+            // Move the whole batch to the ready queue under one lock
+            {
+                lock_guard<mutex> ready_lock(queue_mutex);
+                auto readyAt = chrono::steady_clock::now();
+                for (Process* proc : to_admit) {
+                    proc->readyEnqueuedAt = readyAt;
+                    ready_queue.push(proc);
+                }
+                readyQueueDepth += static_cast<int>(to_admit.size());
+            }
+            if (to_admit.size() == 1) scheduler_cv.notify_one(); // Notify one worker
+            else scheduler_cv.notify_all();
+        }
+
+        else {
+            // If we couldn't admit a process, sleep for a short time to prevent
+            // this loop from running at 100% CPU when memory is full.
+            this_thread::sleep_for(chrono::milliseconds(50));
+        }
+    }
+
+    // --- Cleanup: Wait for all worker threads to complete ---
+    scheduler_cv.notify_all();
+    for (auto& worker : cpu_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+/**
+ * Starts the admission scheduler and the CPU workers and queues every
+ * unfinished process. The configured workload is generated on the first
+ * start unless generateWorkload is false.
+ */
+void startScheduler(bool generateWorkload) {
+    if (isSchedulerRunning) {
+        cout << "Scheduler is already running." << endl;
+        return;
+    }
+
+    // Build the workload before taking any lock; only the main thread adds processes
+    vector<Process> generated;
+    if (generateWorkload && processesCreated.load() == 0) {
+        generated = generateProcessBatch(systemConfig.num_processes, nextPID);
+        nextPID += systemConfig.num_processes;
+    }
+
+    // Lock mutexes in consistent order
+    int queuedProcesses = 0;
+    {
+        lock_guard<mutex> start_lock(processMutex); // Changed from proc_lock
+        lock_guard<mutex> screen_lock(screensMutex);
+        lock_guard<mutex> wait_lock(waiting_queue_mutex);
+        lock_guard<mutex> queue_lock(queue_mutex);
+        lock_guard<mutex> mem_lock(memory_mutex);
+
+        screens.clear();
+        while (!waiting_for_memory_queue.empty()) waiting_for_memory_queue.pop();
+        waitingQueueDepth = 0;
+        current_memory_used = 0;
+
+        // The workers are stopped, so the ready_queue only holds processes whose page-in
+        // completed while stopped; keep those, the rest are queued again below
+        queue<Process*> resumed;
+        for (; !ready_queue.empty(); ready_queue.pop()) {
+            if (ready_queue.front()->pendingPageIn) resumed.push(ready_queue.front());
+        }
+        ready_queue.swap(resumed);
+        readyQueueDepth = static_cast<int>(ready_queue.size());
+
+        if (!generated.empty()) {
+            vector<shared_ptr<ProcessStatus>> newStatuses;
+            newStatuses.reserve(generated.size());
+            for (auto& proc : generated) {
+                newStatuses.push_back(proc.status);
+                int pid = proc.pid;
+                globalProcesses.emplace(pid, std::move(proc));
+            }
+            processesCreated += static_cast<int>(newStatuses.size());
+            registerProcessStatuses(newStatuses);
+        }
+
+        // Add all new processes to the waiting queue. A process with a page-in is owned by
+        // pageFaultService (or already in the ready_queue), which requeues it itself.
+        auto enqueuedAt = chrono::steady_clock::now();
+        for (auto& [pid, proc] : globalProcesses) {
+            if (!proc.isFinished && !proc.pendingPageIn) {
+                proc.admissionEnqueuedAt = enqueuedAt;
+                waiting_for_memory_queue.push(&proc);
+                waitingQueueDepth++;
+                queuedProcesses++;
+            }
+        }
+    }
+
+    isSchedulerRunning = true;
+    // Start the main admission scheduler thread (REVISED)
+    schedulerThread = thread(admissionScheduler);
+    memory_cv.notify_one(); // Kick-start the admission process
+
+    cout << "Scheduler started (" << systemConfig.scheduler
+        << ") with " << queuedProcesses << " processes on " << systemConfig.num_cpu
+        << " cores." << endl;
+}
+
+/**
+ * Stops the admission scheduler and waits for the CPU workers to finish
+ * their current time slice.
+ */
+void stopScheduler() {
+    if (!isSchedulerRunning) return;
+    isSchedulerRunning = false;
+    memory_cv.notify_all(); // Wake up admission scheduler to terminate
+    scheduler_cv.notify_all(); // Wake up all workers to terminate
+    if (schedulerThread.joinable()) {
+        schedulerThread.join();
+    }
+}
+
+/**
+ * Stops every background thread and closes the swap file before exit.
+ */
+void shutdownSystem() {
+    stopScheduler();
+    stopMetricsExporter();
+    pageFaultService.stop();
+    compressedPool.stop();
+    swapDevice.close();
+}
+
+// =================== Scheduler - END =================== //
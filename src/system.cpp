@@ -0,0 +1,513 @@
+/** === AJEL OS: system ===
+ * Global state, config.txt loading and system initialization.
+ */
+
+#include "ajel.h"
+
+// ======================= Global Variables ======================= //
+
+// --- Global System Configuration and Memory Structures ---
+SystemConfig systemConfig;
+vector<FrameInfo> frameTable;
+mutex frameTableMutex;
+std::queue<int> frameEvictionQueue;
+
+atomic<bool> isSchedulerRunning{ false };
+bool isSystemInitialized = false; // New flag to track system initialization
+thread schedulerThread;
+vector<thread> cpu_workers;
+
+mutex processMutex; // Used for protecting shared resources like globalProcesses and cout
+map<int, struct Process> globalProcesses; // Live processes by PID; finished ones are retired to processArchive
+bool screenActive = false;
+
+mutex screensMutex;
+unordered_map<string, class Screen> screens;
+
+// Copy-on-write list of every process's published status. Readers take a
+// reference with atomic_load and never block; writers serialize on the mutex.
+shared_ptr<const vector<shared_ptr<struct ProcessStatus>>> processStatusRegistry =
+    make_shared<const vector<shared_ptr<struct ProcessStatus>>>();
+mutex statusRegistryMutex;
+int archivedInRegistry = 0; // Registry entries already in processArchive (pruned in bulk)
+
+// Append-only summaries of retired (finished) processes, in retirement order
+vector<struct ProcessStatusView> processArchive;
+mutex processArchiveMutex;
+
+// screen -f requests, run by the worker that owns the parent at the end of its next time slice
+unordered_map<int, vector<string>> pendingForks; // Parent PID -> child names
+mutex pendingForksMutex;
+atomic<int> pendingForkCount{ 0 };
+
+// --- Threading & Scheduling Variables ---
+queue<struct Process*> ready_queue; // Queue of processes ready for CPU execution
+mutex queue_mutex;                  // Mutex to protect the ready_queue
+condition_variable scheduler_cv;    // Notifies worker threads about new processes
+
+// --- Memory Management Variables ---
+atomic<int> current_memory_used{ 0 };
+mutex memory_mutex;
+condition_variable memory_cv; // Notifies the admission scheduler about freed memory
+queue<struct Process*> waiting_for_memory_queue; // Processes waiting for memory allocation
+mutex waiting_queue_mutex;
+
+atomic<int> quantumCycleCounter{ 0 };
+int nextPID = 1;
+ImprovedPageReplacement pageReplacer;
+
+// --- For VMStat ---
+atomic<int> pageFaults{ 0 };
+atomic<int> pageReplacements{ 0 };
+atomic<int> pagesPagedIn{ 0 };   // Faults served from the backing store
+atomic<int> zeroFillFaults{ 0 }; // Faults on never-swapped pages, served without I/O
+atomic<int> pagesPrefetched{ 0 };
+atomic<int> prefetchHits{ 0 };     // Prefetched pages that were accessed before eviction
+atomic<int> swapReadCalls{ 0 };    // Vectored reads issued to the swap file
+atomic<int> swapWriteCalls{ 0 };   // Vectored writes issued to the swap file
+atomic<int> asyncPageIns{ 0 };     // Faults whose swap-in ran while the core moved on
+atomic<int> pagesCompressed{ 0 };  // Evicted pages stored in the compressed pool instead of the swap file
+atomic<int> compressedPoolHits{ 0 }; // Pages loaded from the compressed pool without I/O
+atomic<int> pagesSpilled{ 0 };     // Cold pool entries moved to the swap file to make room
+atomic<int> compressedPoolPages{ 0 };
+atomic<long long> compressedPoolBytes{ 0 };
+atomic<int> cowFaults{ 0 };       // Faults on copy-on-write pages, served from the shared copy without I/O
+atomic<int> cowPageCopies{ 0 };   // Shared pages copied by a write
+atomic<int> sharedPageWrites{ 0 }; // Writes recorded on a page still shared copy-on-write; always 0 unless a breakCopyOnWrite is missing
+atomic<int> processesForked{ 0 };
+atomic<int> programImages{ 0 };        // Live shared program images
+atomic<int> programCacheHits{ 0 };     // Processes that reused a cached program image
+atomic<int> programCacheMisses{ 0 };   // Program images built
+atomic<int> blockedOnIoCount{ 0 }; // Processes parked until their swap-in completes
+atomic<int> totalCpuTicks{ 0 };
+atomic<int> activeCpuTicks{ 0 };
+atomic<int> idleCpuTicks{ 0 };
+
+// --- Lock-free counters for the metrics snapshot (vmstat --json, Prometheus export) ---
+atomic<int> processesCreated{ 0 };
+atomic<int> processesStarted{ 0 };
+atomic<int> processesFinished{ 0 };
+atomic<int> processesViolated{ 0 };
+atomic<int> usedFrameCount{ 0 };
+atomic<int> dirtyFrameCount{ 0 };
+atomic<int> busyCoreCount{ 0 };
+vector<atomic<long long>> coreBusyMicros; // Time each core spent running processes; sized by initializeSystem()
+atomic<int> readyQueueDepth{ 0 };
+atomic<int> waitingQueueDepth{ 0 };
+atomic<long long> instructionsExecuted{ 0 };
+
+thread metricsExporterThread;
+atomic<bool> isMetricsExporterRunning{ false };
+mutex metrics_exporter_mutex;
+condition_variable metrics_exporter_cv; // Wakes the exporter early on shutdown
+
+// --- For perf-stats (latency histograms, in microseconds) ---
+LatencyHistogram readyQueueWaitHist;     // ready_queue push -> pop in cpu_worker_main
+LatencyHistogram admissionWaitHist;      // waiting_for_memory_queue push -> admission
+LatencyHistogram turnaroundHist;         // endClock - startClock of finished processes
+LatencyHistogram pageInWaitHist;         // Time a process spends blocked on an async swap-in
+LatencyHistogram instructionExecHist[INSTRUCTION_TYPE_COUNT]; // executeInstruction() by type
+
+// --- Shared services ---
+ProgramCache programCache;
+SwapDevice swapDevice; // Opened by initializeSystem()
+CompressedSwapPool compressedPool; // Sized by initializeSystem()
+PageFaultService pageFaultService; // Started by initializeSystem()
+
+// ===================== Global Variables - END ===================== //
+
+// ===================== System ===================== //
+
+/**
+ * Parses an instruction-mix value such as "print:1,declare:1,add:2,read:3,write:3".
+ * Types that are not listed get weight 0. Throws invalid_argument on bad input.
+ */
+void parseInstructionMix(const string& value, WorkloadProfile& workload) {
+    WorkloadProfile parsed = workload;
+    parsed.mix_print = parsed.mix_declare = parsed.mix_add = 0;
+    parsed.mix_subtract = parsed.mix_read = parsed.mix_write = 0;
+
+    stringstream ss(value);
+    string entry;
+    while (getline(ss, entry, ',')) {
+        size_t colon = entry.find(':');
+        if (colon == string::npos) throw invalid_argument(entry);
+        string type = entry.substr(0, colon);
+        type.erase(0, type.find_first_not_of(" \t"));
+        type.erase(type.find_last_not_of(" \t") + 1);
+        int weight = stoi(entry.substr(colon + 1));
+
+        if (type == "print") parsed.mix_print = weight;
+        else if (type == "declare") parsed.mix_declare = weight;
+        else if (type == "add") parsed.mix_add = weight;
+        else if (type == "subtract") parsed.mix_subtract = weight;
+        else if (type == "read") parsed.mix_read = weight;
+        else if (type == "write") parsed.mix_write = weight;
+        else throw invalid_argument(type);
+    }
+    workload = parsed;
+}
+
+/**
+ * Load configuration from config.txt file, or from source when one is given
+ * (--bench scenarios).
+ * Returns true if config was loaded successfully, false otherwise
+ */
+bool loadConfig(istream* source) {
+    ifstream configFile;
+    if (!source) configFile.open("config.txt");
+    if (!source && !configFile.is_open()) {
+        cout << "Error: config.txt file not found!" << endl;
+        cout << "Please create a config.txt file with the following format:" << endl;
+        cout << "num-cpu=4" << endl;
+        cout << "scheduler=fcfs" << endl;
+        cout << "quantum-cycles=5" << endl;
+        cout << "batch-process-freq=1" << endl;
+        cout << "min-ins=1000" << endl;
+        cout << "max-ins=2000" << endl;
+        cout << "delay-per-exec=100" << endl;
+        cout << "max-overall-mem=8192" << endl;
+        cout << "mem-per-frame=256" << endl;
+        cout << "mem-per-proc=1024" << endl;
+        return false;
+    }
+
+    string line;
+    vector<string> missingKeys;
+    vector<string> requiredKeys = { "num-cpu", "scheduler", "quantum-cycles",
+                                   "batch-process-freq", "min-ins", "max-ins", "delay-per-exec",
+                                   "max-overall-mem", "mem-per-frame", "min-mem-per-proc", "max-mem-per-proc" };
+    vector<bool> keyFound(requiredKeys.size(), false);
+
+    cout << "Reading configuration from " << (source ? "benchmark scenario" : "config.txt") << "..." << endl;
+    istream& config = source ? *source : configFile;
+
+    while (getline(config, line)) {
+        // Skip empty lines and comments
+        if (line.empty() || line[0] == '#') continue;
+
+        size_t equalPos = line.find('=');
+        if (equalPos == string::npos) {
+            cout << "Warning: Invalid line format ignored: " << line << endl;
+            continue;
+        }
+
+        string key = line.substr(0, equalPos);
+        string value = line.substr(equalPos + 1);
+
+        // Trim whitespace
+        key.erase(0, key.find_first_not_of(" \t\r\n"));
+        key.erase(key.find_last_not_of(" \t\r\n") + 1);
+        value.erase(0, value.find_first_not_of(" \t\r\n"));
+        value.erase(value.find_last_not_of(" \t\r\n") + 1);
+
+        try {
+            // Parse configuration values
+            if (key == "num-cpu") {
+                systemConfig.num_cpu = stoi(value);
+                keyFound[0] = true;
+                cout << "  ✓ num-cpu: " << systemConfig.num_cpu << endl;
+            }
+            else if (key == "scheduler") {
+                systemConfig.scheduler = value;
+                keyFound[1] = true;
+                cout << "  ✓ scheduler: " << systemConfig.scheduler << endl;
+            }
+            else if (key == "quantum-cycles") {
+                systemConfig.quantum_cycles = stoi(value);
+                keyFound[2] = true;
+                cout << "  ✓ quantum-cycles: " << systemConfig.quantum_cycles << endl;
+            }
+            else if (key == "batch-process-freq") {
+                systemConfig.batch_process_freq = stoi(value);
+                keyFound[3] = true;
+                cout << "  ✓ batch-process-freq: " << systemConfig.batch_process_freq << endl;
+            }
+            else if (key == "min-ins") {
+                systemConfig.min_ins = stoi(value);
+                keyFound[4] = true;
+                cout << "  ✓ min-ins: " << systemConfig.min_ins << endl;
+            }
+            else if (key == "max-ins") {
+                systemConfig.max_ins = stoi(value);
+                keyFound[5] = true;
+                cout << "  ✓ max-ins: " << systemConfig.max_ins << endl;
+            }
+            else if (key == "delay-per-exec") {
+                systemConfig.delay_per_exec = stoi(value);
+                keyFound[6] = true;
+                cout << "  ✓ delay-per-exec: " << systemConfig.delay_per_exec << " ms" << endl;
+            }
+            else if (key == "max-overall-mem") {
+                systemConfig.max_overall_mem = stoi(value);
+                keyFound[7] = true;
+                cout << "  ✓ max-overall-mem: " << systemConfig.max_overall_mem << endl;
+            }
+            else if (key == "mem-per-frame") {
+                systemConfig.mem_per_frame = stoi(value);
+                keyFound[8] = true;
+                cout << "  ✓ mem-per-frame: " << systemConfig.mem_per_frame << endl;
+            }
+            else if (key == "min-mem-per-proc") {
+                systemConfig.min_mem_per_proc = stoi(value);
+                keyFound[9] = true;
+                cout << "  ✓ min-mem-per-proc: " << systemConfig.min_mem_per_proc << endl;
+            }
+            else if (key == "max-mem-per-proc") {
+                systemConfig.max_mem_per_proc = stoi(value);
+                keyFound[10] = true;
+                cout << "  ✓ max-mem-per-proc: " << systemConfig.max_mem_per_proc << endl;
+            }
+            // Optional keys (no keyFound entry)
+            else if (key == "metrics-export-interval") {
+                systemConfig.metrics_export_interval = stoi(value);
+                cout << "  ✓ metrics-export-interval: " << systemConfig.metrics_export_interval << " ms" << endl;
+            }
+            else if (key == "metrics-export-file") {
+                systemConfig.metrics_export_file = value;
+                cout << "  ✓ metrics-export-file: " << systemConfig.metrics_export_file << endl;
+            }
+            else if (key == "num-processes") {
+                systemConfig.num_processes = stoi(value);
+                cout << "  ✓ num-processes: " << systemConfig.num_processes << endl;
+            }
+            else if (key == "seed") {
+                systemConfig.seed = stoull(value);
+                systemConfig.has_seed = true;
+                cout << "  ✓ seed: " << systemConfig.seed << endl;
+            }
+            else if (key == "prefetch-pages") {
+                systemConfig.prefetch_pages = stoi(value);
+                cout << "  ✓ prefetch-pages: " << systemConfig.prefetch_pages << endl;
+            }
+            else if (key == "fault-around-pages") {
+                systemConfig.fault_around_pages = stoi(value);
+                cout << "  ✓ fault-around-pages: " << systemConfig.fault_around_pages << endl;
+            }
+            else if (key == "page-fault-io") {
+                systemConfig.page_fault_io = value;
+                cout << "  ✓ page-fault-io: " << systemConfig.page_fault_io << endl;
+            }
+            else if (key == "io-threads") {
+                systemConfig.io_threads = stoi(value);
+                cout << "  ✓ io-threads: " << systemConfig.io_threads << endl;
+            }
+            else if (key == "compressed-pool-size") {
+                systemConfig.compressed_pool_size = stoi(value);
+                cout << "  ✓ compressed-pool-size: " << systemConfig.compressed_pool_size << " bytes" << endl;
+            }
+            else if (key == "max-user-instructions") {
+                systemConfig.max_user_instructions = stoi(value);
+                cout << "  ✓ max-user-instructions: " << systemConfig.max_user_instructions << endl;
+            }
+            else if (key == "instruction-chunk-size") {
+                systemConfig.instruction_chunk_size = stoi(value);
+                cout << "  ✓ instruction-chunk-size: " << systemConfig.instruction_chunk_size << endl;
+            }
+            else if (key == "instruction-mix") {
+                parseInstructionMix(value, systemConfig.workload);
+                cout << "  ✓ instruction-mix: " << value << endl;
+            }
+            else if (key == "address-distribution") {
+                if (value == "uniform") systemConfig.workload.address_distribution = WorkloadProfile::UNIFORM;
+                else if (value == "zipf") systemConfig.workload.address_distribution = WorkloadProfile::ZIPF;
+                else if (value == "sequential") systemConfig.workload.address_distribution = WorkloadProfile::SEQUENTIAL;
+                else if (value == "stride") systemConfig.workload.address_distribution = WorkloadProfile::STRIDE;
+                else if (value == "hot-cold") systemConfig.workload.address_distribution = WorkloadProfile::HOT_COLD;
+                else if (value == "phased") systemConfig.workload.address_distribution = WorkloadProfile::PHASED;
+                else throw invalid_argument(value);
+                cout << "  ✓ address-distribution: " << value << endl;
+            }
+            else if (key == "zipf-exponent") {
+                systemConfig.workload.zipf_exponent = stod(value);
+                cout << "  ✓ zipf-exponent: " << systemConfig.workload.zipf_exponent << endl;
+            }
+            else if (key == "address-stride") {
+                systemConfig.workload.address_stride = stoi(value);
+                cout << "  ✓ address-stride: " << systemConfig.workload.address_stride << endl;
+            }
+            else if (key == "hot-fraction") {
+                systemConfig.workload.hot_fraction = stod(value);
+                cout << "  ✓ hot-fraction: " << systemConfig.workload.hot_fraction << endl;
+            }
+            else if (key == "hot-probability") {
+                systemConfig.workload.hot_probability = stod(value);
+                cout << "  ✓ hot-probability: " << systemConfig.workload.hot_probability << endl;
+            }
+            else if (key == "working-set-pages") {
+                systemConfig.workload.working_set_pages = stoi(value);
+                cout << "  ✓ working-set-pages: " << systemConfig.workload.working_set_pages << endl;
+            }
+            else if (key == "phase-length") {
+                systemConfig.workload.phase_length = stoi(value);
+                cout << "  ✓ phase-length: " << systemConfig.workload.phase_length << endl;
+            }
+            else {
+                cout << "Warning: Unknown configuration key ignored: " << key << endl;
+            }
+        }
+        catch (const exception) {
+            cout << "Error: Invalid value for " << key << ": " << value << endl;
+            configFile.close();
+            return false;
+        }
+    }
+
+    configFile.close();
+
+    // Check for missing required keys
+    for (size_t i = 0; i < requiredKeys.size(); ++i) {
+        if (!keyFound[i]) {
+            missingKeys.push_back(requiredKeys[i]);
+        }
+    }
+
+    if (!missingKeys.empty()) {
+        cout << "Error: Missing required configuration keys:" << endl;
+        for (const auto& key : missingKeys) {
+            cout << "  - " << key << endl;
+        }
+        return false;
+    }
+
+    // Validate configuration values
+    if (!systemConfig.isValid()) {
+        cout << "Error: Invalid configuration values detected:" << endl;
+        if (systemConfig.num_cpu <= 0) cout << "  - num-cpu must be greater than 0" << endl;
+        if (systemConfig.scheduler.empty()) cout << "  - scheduler cannot be empty" << endl;
+        if (systemConfig.quantum_cycles <= 0) cout << "  - quantum-cycles must be greater than 0" << endl;
+        if (systemConfig.batch_process_freq <= 0) cout << "  - batch-process-freq must be greater than 0" << endl;
+        if (systemConfig.min_ins <= 0) cout << "  - min-ins must be greater than 0" << endl;
+        if (systemConfig.max_ins <= 0) cout << "  - max-ins must be greater than 0" << endl;
+        if (systemConfig.max_ins < systemConfig.min_ins) cout << "  - max-ins must be >= min-ins" << endl;
+        if (systemConfig.delay_per_exec < 0) cout << "  - delay-per-exec must be >= 0" << endl;
+        if (systemConfig.metrics_export_interval < 0) cout << "  - metrics-export-interval must be >= 0" << endl;
+        if (systemConfig.num_processes <= 0) cout << "  - num-processes must be greater than 0" << endl;
+        if (systemConfig.instruction_chunk_size < 0) cout << "  - instruction-chunk-size must be >= 0" << endl;
+        if (systemConfig.prefetch_pages < 0) cout << "  - prefetch-pages must be >= 0" << endl;
+        if (systemConfig.fault_around_pages < 0) cout << "  - fault-around-pages must be >= 0" << endl;
+        if (systemConfig.page_fault_io != "sync" && systemConfig.page_fault_io != "async" &&
+            systemConfig.page_fault_io != "io_uring" && systemConfig.page_fault_io != "threads") {
+            cout << "  - page-fault-io must be sync, async, io_uring or threads" << endl;
+        }
+        if (systemConfig.io_threads <= 0) cout << "  - io-threads must be greater than 0" << endl;
+        if (systemConfig.compressed_pool_size < 0) cout << "  - compressed-pool-size must be >= 0" << endl;
+        if (systemConfig.max_user_instructions <= 0) cout << "  - max-user-instructions must be greater than 0" << endl;
+        if (!systemConfig.workload.isValid()) {
+            cout << "  - instruction-mix weights must be >= 0 with a positive total, zipf-exponent > 0" << endl;
+            cout << "  - address-stride, working-set-pages and phase-length must be > 0" << endl;
+            cout << "  - hot-fraction must be in (0, 1], hot-probability in [0, 1]" << endl;
+        }
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Initialize the system with configuration parameters, read from config.txt
+ * unless configSource is given.
+ */
+void initializeSystem(istream* configSource) {
+    if (isSystemInitialized) {
+        cout << "System is already initialized." << endl;
+        cout << "If you want to reinitialize with new config values, please restart the program." << endl;
+        return;
+    }
+
+    cout << "Initializing system..." << endl;
+
+    // Load configuration from config.txt
+    if (!loadConfig(configSource)) {
+        cout << "\nSystem initialization failed!" << endl;
+        cout << "Please fix the config.txt file and try again." << endl;
+        return;
+    }
+
+    // Display successfully loaded configuration
+    cout << "\n" << string(50, '=') << endl;
+    cout << "SYSTEM CONFIGURATION LOADED SUCCESSFULLY" << endl;
+    cout << string(50, '=') << endl;
+    cout << "├── Number of CPUs: " << systemConfig.num_cpu << endl;
+    cout << "├── Scheduler Algorithm: " << systemConfig.scheduler << endl;
+    cout << "├── Quantum Cycles: " << systemConfig.quantum_cycles << endl;
+    cout << "├── Batch Process Frequency: " << systemConfig.batch_process_freq << endl;
+    cout << "├── Min Instructions: " << systemConfig.min_ins << endl;
+    cout << "├── Max Instructions: " << systemConfig.max_ins << endl;
+    cout << "├── Delay per Execution: " << systemConfig.delay_per_exec << " ms" << endl;
+    // Display memory parameters
+    cout << "├── Max Overall Memory: " << systemConfig.max_overall_mem << " KB" << endl;
+    cout << "├── Memory per Frame: " << systemConfig.mem_per_frame << " KB" << endl;
+    cout << "├── Min Memory per Process: " << systemConfig.min_mem_per_proc << " KB" << endl;
+    cout << "├── Max Memory per Process: " << systemConfig.max_mem_per_proc << " KB" << endl;
+    if (!systemConfig.has_seed) {
+        random_device entropy;
+        systemConfig.seed = (static_cast<uint64_t>(entropy()) << 32) ^ entropy();
+    }
+    cout << "├── Processes at Start: " << systemConfig.num_processes << endl;
+    cout << "├── User Program Limit: " << systemConfig.max_user_instructions << " instructions" << endl;
+    const WorkloadProfile& workload = systemConfig.workload;
+    cout << "├── Instruction Mix: print " << workload.mix_print << ", declare " << workload.mix_declare
+        << ", add " << workload.mix_add << ", subtract " << workload.mix_subtract
+        << ", read " << workload.mix_read << ", write " << workload.mix_write << endl;
+    cout << "├── Address Distribution: ";
+    switch (workload.address_distribution) {
+    case WorkloadProfile::ZIPF: cout << "zipf (s=" << workload.zipf_exponent << ")"; break;
+    case WorkloadProfile::SEQUENTIAL: cout << "sequential"; break;
+    case WorkloadProfile::STRIDE: cout << "stride (" << workload.address_stride << " bytes)"; break;
+    case WorkloadProfile::HOT_COLD:
+        cout << "hot-cold (" << workload.hot_probability * 100 << "% of accesses to "
+            << workload.hot_fraction * 100 << "% of memory)";
+        break;
+    case WorkloadProfile::PHASED:
+        cout << "phased (" << workload.working_set_pages << " pages, "
+            << workload.phase_length << " accesses per phase)";
+        break;
+    default: cout << "uniform"; break;
+    }
+    cout << endl;
+    cout << "├── Prefetch: " << systemConfig.prefetch_pages << " pages ahead, fault-around "
+        << systemConfig.fault_around_pages << " pages" << endl;
+    cout << "├── Compressed Swap Pool: ";
+    if (systemConfig.compressed_pool_size > 0) cout << systemConfig.compressed_pool_size << " bytes" << endl;
+    else cout << "off" << endl;
+    cout << "├── Page-Fault I/O: " << systemConfig.page_fault_io;
+    if (systemConfig.page_fault_io == "threads") cout << " (" << systemConfig.io_threads << " threads)";
+    cout << endl;
+    cout << "└── Workload Seed: " << systemConfig.seed << (systemConfig.has_seed ? "" : " (random)") << endl;
+    cout << string(50, '=') << endl;
+
+    // Initialize Frame Table
+    int totalFrames = systemConfig.max_overall_mem / systemConfig.mem_per_frame;
+    frameTable.resize(totalFrames);
+    coreBusyMicros = vector<atomic<long long>>(systemConfig.num_cpu);
+
+    for (int i = 0; i < totalFrames; ++i) {
+        frameTable[i] = FrameInfo(); // Default isFree = true
+    }
+
+    // Initialize system components
+    globalProcesses.clear();
+    programCache.clear(); // Generated programs depend on the configuration
+    if (!swapDevice.open("csopesy-backing-store.bin", max(systemConfig.mem_per_frame, SYMBOL_TABLE_BYTES))) {
+        cout << "Warning: Could not open csopesy-backing-store.bin; evicted pages will not be swapped." << endl;
+    }
+    compressedPool.configure(systemConfig.compressed_pool_size);
+    pageFaultService.start(systemConfig.page_fault_io, systemConfig.io_threads);
+    if (systemConfig.page_fault_io == "io_uring" && strcmp(pageFaultService.backendName(), "io_uring") != 0) {
+        cout << "Warning: io_uring is not available; page faults use " << systemConfig.io_threads
+            << " I/O threads instead." << endl;
+    }
+
+    // Mark system as initialized
+    isSystemInitialized = true;
+    startMetricsExporter();
+    cout << "\nSystem initialized successfully!" << endl;
+    if (isMetricsExporterRunning) {
+        cout << "Exporting metrics to " << systemConfig.metrics_export_file
+            << " every " << systemConfig.metrics_export_interval << " ms." << endl;
+    }
+    cout << "You can now use scheduler-start to begin process scheduling." << endl;
+}
+
+// =================== System - END =================== //